@@ -5,6 +5,11 @@ Global Random Variables
         #include "Random.h" from any .cpp file in your project that needs to generate random numbers.
         Call Random::get(min, max) to generate a random number between min and max (inclusive). No initialization or setup is required.
     This is one of the few cases a non-const global variable is reasonable to use.
+
+    The version below is the plain learncpp one, except that the engine isn't hard-coded to std::mt19937: defining RANDOM_ENGINE
+    (e.g. -DRANDOM_ENGINE=std::mt19937_64) picks any standard engine that can be seeded from a std::seed_seq.
+    The copy in "Chapter 15: More Classes/chapter quiz/random.h" has grown a few extras, including its own smaller/faster engines
+    (PCG32, xoshiro256**, SplitMix64, or the LCG from "intro to rng.cpp") for RANDOM_ENGINE.
 */
 
 #ifndef RANDOM_MT_H
@@ -19,10 +24,17 @@ Global Random Variables
 // Freely redistributable, courtesy of learncpp.com (https://www.learncpp.com/cpp-tutorial/global-random-numbers-random-h/)
 namespace Random
 {
-	// Returns a seeded Mersenne Twister
+	// The engine type, std::mt19937 unless RANDOM_ENGINE says otherwise (every file must agree on it)
+#ifdef RANDOM_ENGINE
+	using Engine = RANDOM_ENGINE;
+#else
+	using Engine = std::mt19937;
+#endif
+
+	// Returns a seeded engine (a Mersenne Twister by default)
 	// Note: we'd prefer to return a std::seed_seq (to initialize a std::mt19937), but std::seed can't be copied, so it can't be returned by value.
 	// Instead, we'll create a std::mt19937, seed it, and then return the std::mt19937 (which can be copied).
-	inline std::mt19937 generate()
+	inline Engine generate()
 	{
 		std::random_device rd{};
 
@@ -31,12 +43,12 @@ namespace Random
 			static_cast<std::seed_seq::result_type>(std::chrono::steady_clock::now().time_since_epoch().count()),
 				rd(), rd(), rd(), rd(), rd(), rd(), rd() };
 
-		return std::mt19937{ ss };
+		return Engine{ ss };
 	}
 
-	// Here's our global std::mt19937 object.
+	// Here's our global engine object (still called mt, as most engines will be a Mersenne Twister).
 	// The inline keyword means we only have one global instance for our whole program.
-	inline std::mt19937 mt{ generate() }; // generates a seeded std::mt19937 and copies it into our global object
+	inline Engine mt{ generate() }; // generates a seeded engine and copies it into our global object
 
 	// Generate a random int between [min, max] (inclusive)
         // * also handles cases where the two arguments have different types but can be converted to int
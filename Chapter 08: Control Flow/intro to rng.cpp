@@ -52,12 +52,53 @@ unsigned int LCG16() // our PRNG
     return s_state % 32768; // then we use the new state to generate the next number in the sequence
 }
 
+/*
+Compile-Time PRNG
+    LCG16() keeps its state in a static local variable, and static locals aren't allowed in constexpr functions, so it can only run at runtime.
+    If the state is passed in by reference instead, the same recurrence becomes an ordinary constexpr function.
+    A consteval function can then run it to fill a whole table while compiling, and the finished table is stored in the
+    program's read-only data (.rodata), so "generating" it costs nothing when the program runs.
+    The CONSTEVAL macro from "consteval and more constexpr.cpp" does the same for a single expression.
+
+    "Chapter 15: More Classes/chapter quiz/random.h" generalizes this as Random::LinearCongruential and Random::table.
+*/
+
+// This uses a variadic preprocessor macro (the #define, ..., and __VA_ARGS__) to define an consteval lambda that is immediately invoked (by the trailing parentheses).
+#define CONSTEVAL(...) []() consteval { return __VA_ARGS__; }() // C++20 version per Jan Scultke (https://stackoverflow.com/a/77107431/460250), with () since C++20 requires it before consteval
+
+#include <array>
+
+// Same recurrence as LCG16(), but the caller owns the state
+constexpr unsigned int LCG16(unsigned int& state)
+{
+    state = 8253729 * state + 2396403;
+    return state % 32768;
+}
+
+// Returns the first N numbers LCG16 produces from the given seed, computed at compile time
+template <std::size_t N>
+consteval std::array<unsigned int, N> LCG16Table(unsigned int seed)
+{
+    std::array<unsigned int, N> table{};
+    for (unsigned int& value : table)
+        value = LCG16(seed);
+    return table;
+}
+
 int main()
 {
+    constexpr std::array<unsigned int, 100> table{ LCG16Table<100>(0) }; // computed by the compiler
+    static_assert(table[0] == 4339); // so we can even check it at compile time
+
+    std::cout << "The 10th number will be " << CONSTEVAL(LCG16Table<10>(0)[9]) << '\n';
+
     // Print 100 random numbers
     for (int count{ 1 }; count <= 100; ++count)
     {
-        std::cout << LCG16() << '\t';
+        const unsigned int value{ LCG16() };
+        if (value != table[static_cast<std::size_t>(count - 1)]) // the runtime version agrees with the compile-time table
+            std::cout << "mismatch! ";
+        std::cout << value << '\t';
 
         // If we've printed 10 numbers, start a new row
         if (count % 10 == 0)
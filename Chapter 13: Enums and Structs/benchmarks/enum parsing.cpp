@@ -0,0 +1,120 @@
+/*
+Enum Parsing
+    Parses a long stream of pet names (with some invalid tokens mixed in) two ways:
+    * getPetFromString as written in "overloading IO operators.cpp": an if statement per name, each a string compare
+    * EnumNames::parse (../enumtable.h): one perfect-hash lookup and a single string compare
+    and checks that both give the same answers. The same is done in the other direction, Pet -> name.
+
+    Build: g++ -std=c++20 -O2 "enum parsing.cpp"
+    Usage: ./a.out [tokens]
+*/
+
+#include "../enumtable.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum Pet
+{
+    cat,   // 0
+    dog,   // 1
+    pig,   // 2
+    whale, // 3
+};
+
+constexpr auto petNames{ makeEnumNames<Pet>("cat", "dog", "pig", "whale") };
+
+// The if-chain from "overloading IO operators.cpp"
+constexpr std::optional<Pet> getPetFromStringChain(std::string_view sv)
+{
+    if (sv == "cat")   return cat;
+    if (sv == "dog")   return dog;
+    if (sv == "pig")   return pig;
+    if (sv == "whale") return whale;
+
+    return {};
+}
+
+constexpr std::string_view getPetNameSwitch(Pet pet)
+{
+    switch (pet)
+    {
+    case cat:   return "cat";
+    case dog:   return "dog";
+    case pig:   return "pig";
+    case whale: return "whale";
+    default:    return "???";
+    }
+}
+
+static_assert(petNames.parse("whale") == whale && !petNames.parse("whales") && !petNames.parse(""));
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 20'000'000 };
+
+    // about one token in five is not a pet
+    constexpr std::string_view vocabulary[]{ "cat", "dog", "pig", "whale", "cat", "dog", "pig", "whale", "cow", "whales", "do", "" };
+    std::mt19937 mt{ 12345 };
+    std::uniform_int_distribution<std::size_t> pick{ 0, std::size(vocabulary) - 1 };
+    std::vector<std::string_view> tokens(count);
+    for (std::string_view& token : tokens)
+        token = vocabulary[pick(mt)];
+
+    // each parse is folded into a checksum so none of them can be optimized away
+    const auto parseAll = [&tokens](auto parse) {
+        std::uint64_t checksum{ 0 };
+        for (std::string_view token : tokens)
+        {
+            const std::optional<Pet> pet{ parse(token) };
+            checksum = checksum * 31 + (pet ? static_cast<std::uint64_t>(*pet) + 1 : 0);
+        }
+        return checksum;
+    };
+
+    std::uint64_t chainSum{};
+    std::uint64_t tableSum{};
+    const double chainSeconds{ secondsFor([&] { chainSum = parseAll(getPetFromStringChain); }) };
+    const double tableSeconds{ secondsFor([&] { tableSum = parseAll([](std::string_view sv) { return petNames.parse(sv); }); }) };
+
+    std::vector<Pet> pets(count);
+    for (Pet& pet : pets)
+        pet = static_cast<Pet>(mt() % 4);
+
+    const auto nameAll = [&pets](auto name) {
+        std::size_t length{ 0 };
+        for (Pet pet : pets)
+            length += name(pet).size();
+        return length;
+    };
+
+    std::size_t switchLength{};
+    std::size_t tableLength{};
+    const double switchSeconds{ secondsFor([&] { switchLength = nameAll(getPetNameSwitch); }) };
+    const double nameSeconds{ secondsFor([&] { tableLength = nameAll([](Pet pet) { return petNames.name(pet); }); }) };
+
+    const double n{ static_cast<double>(count) };
+    std::cout << "method\tlookups/s\n";
+    std::cout << "getPetFromString (if chain)\t" << n / chainSeconds << '\n';
+    std::cout << "EnumNames::parse\t" << n / tableSeconds << '\n';
+    std::cout << "getPetName (switch)\t" << n / switchSeconds << '\n';
+    std::cout << "EnumNames::name\t" << n / nameSeconds << '\n';
+    std::cout << "same results: " << (chainSum == tableSum && switchLength == tableLength ? "yes" : "NO") << '\n';
+
+    return 0;
+}
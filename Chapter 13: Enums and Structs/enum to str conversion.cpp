@@ -5,11 +5,16 @@ Enumeration to String
 
     For input, we could ask for an integer from the user and then cast it to the enum. This is a bit clunky and also requires checking the integer value being in the valid enum range before casting.
     Instead, the user could input a string, and the program uses if statements and an std::optional to convert it into the appropriate enum.
+
+    enumtable.h generalizes the array approach: one constexpr declaration per enum gives a lookup array for enum -> string,
+    plus a perfect hash (worked out by the compiler) for string -> enum.
 */
 
 #include <iostream>
 #include <string_view>
 
+#include "enumtable.h"
+
 enum Color
 {
     black,
@@ -17,15 +22,12 @@ enum Color
     blue,
 };
 
+// The names must be listed in enumerator order
+constexpr auto colorNames{ makeEnumNames<Color>("black", "red", "blue") };
+
 constexpr std::string_view getColorName(Color color) // this works since C-style strings exist for the program duration
 {
-    switch (color)
-    {
-    case black: return "black";
-    case red:   return "red";
-    case blue:  return "blue";
-    default:    return "???";
-    }
+    return colorNames.name(color); // "???" for anything that isn't a Color enumerator
 }
 
 int main()
@@ -34,5 +36,7 @@ int main()
 
     std::cout << "Your shirt is " << getColorName(shirt) << '\n';
 
+    static_assert(colorNames.parse("red") == red); // the reverse direction, also usable at compile time
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,122 @@
+#ifndef ENUMTABLE_H
+#define ENUMTABLE_H
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+// Table-driven enum <-> string conversion, built entirely at compile time.
+// "enum to str conversion.cpp" maps enumerators to names with a switch, and "overloading IO operators.cpp" maps names back
+// with a chain of if statements, comparing the input against every name in turn. With an EnumNames table, each enum gets
+// one declaration listing its names in enumerator order:
+//
+//     constexpr auto petNames{ makeEnumNames<Pet>("cat", "dog", "pig", "whale") };
+//
+//     petNames.name(dog)      -> "dog"        (an array lookup)
+//     petNames.parse("pig")   -> Pet::pig     (one hash and one string compare, however many names there are)
+//     petNames.parse("cow")   -> std::nullopt
+//
+// The reverse direction uses a perfect hash: when the table is built, the compiler tries seeds for the hash function
+// until every name lands in its own slot of a small table, so parse() never has to look at more than one candidate.
+// The hash only looks at the length and the first and last characters, which is enough to tell most sets of names
+// apart; if no seed separates them that way, the table falls back to hashing every character.
+// The enumerators must be numbered 0, 1, 2, ... (the default), and E can also be a plain integer type.
+template <typename E, std::size_t N>
+class EnumNames
+{
+public:
+    static constexpr std::size_t tableSize{ std::bit_ceil(2 * N) }; // at most half full, so a seed turns up quickly
+
+    constexpr explicit EnumNames(const std::array<std::string_view, N>& names) : m_names{ names }
+    {
+        for (std::size_t i{ 0 }; i < N; ++i)
+            for (std::size_t j{ 0 }; j < i; ++j)
+                if (names[i] == names[j])
+                    throw "EnumNames: two enumerators have the same name"; // a compile error in a constant expression
+
+        constexpr std::uint32_t quickSeeds{ 4096 }; // give up on the quick hash after this many tries
+        for (m_seed = 0;; ++m_seed)
+        {
+            if (m_seed == quickSeeds && !m_fullHash)
+            {
+                m_fullHash = true;
+                m_seed = 0;
+            }
+            if (tryFill())
+                return;
+        }
+    }
+
+    static constexpr std::size_t size() { return N; }
+
+    // Returns the name of value, or unknown if value isn't one of the listed enumerators
+    constexpr std::string_view name(E value, std::string_view unknown = "???") const
+    {
+        const auto index{ static_cast<std::size_t>(value) };
+        return index < N ? m_names[index] : unknown;
+    }
+
+    // Returns the enumerator called text, or std::nullopt if there isn't one
+    constexpr std::optional<E> parse(std::string_view text) const
+    {
+        const std::uint16_t slot{ m_slots[slotOf(text)] };
+        if (slot == 0 || m_names[slot - 1] != text)
+            return std::nullopt;
+        return static_cast<E>(slot - 1);
+    }
+
+private:
+    std::array<std::string_view, N> m_names{};
+    std::array<std::uint16_t, tableSize> m_slots{}; // 0 = empty, otherwise 1 + the enumerator's value
+    std::uint32_t m_seed{ 0 };
+    bool m_fullHash{ false };
+
+    // Puts every name in its slot for the current seed. Returns false if two names want the same slot.
+    constexpr bool tryFill()
+    {
+        m_slots = {};
+        for (std::size_t i{ 0 }; i < N; ++i)
+        {
+            std::uint16_t& slot{ m_slots[slotOf(m_names[i])] };
+            if (slot != 0)
+                return false;
+            slot = static_cast<std::uint16_t>(i + 1);
+        }
+        return true;
+    }
+
+    constexpr std::size_t slotOf(std::string_view text) const
+    {
+        std::uint32_t hash{ m_seed };
+        if (!m_fullHash)
+        {
+            const std::uint32_t first{ text.empty() ? 0u : static_cast<unsigned char>(text.front()) };
+            const std::uint32_t last{ text.empty() ? 0u : static_cast<unsigned char>(text.back()) };
+            hash ^= static_cast<std::uint32_t>(text.size()) | first << 8 | last << 16;
+            hash *= 0x9E3779B1u; // Knuth's multiplicative hash
+        }
+        else
+        {
+            // FNV-1a over every character, started from the seed
+            hash ^= 2166136261u;
+            for (char c : text)
+            {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 16777619u;
+            }
+        }
+        return (hash ^ hash >> 16) & (tableSize - 1);
+    }
+};
+
+// Builds an EnumNames<E, N> from the names of E's enumerators, in order
+template <typename E, typename... Names>
+constexpr EnumNames<E, sizeof...(Names)> makeEnumNames(Names... names)
+{
+    return EnumNames<E, sizeof...(Names)>{ std::array<std::string_view, sizeof...(Names)>{ names... } };
+}
+
+#endif
@@ -18,6 +18,8 @@ Overloading the I/O Operators
 #include <string>
 #include <string_view>
 
+#include "enumtable.h"
+
 enum Color
 {
 	black,
@@ -25,15 +27,12 @@ enum Color
 	blue,
 };
 
+// One table per enum gives both directions (see enumtable.h)
+constexpr auto colorNames{ makeEnumNames<Color>("black", "red", "blue") };
+
 constexpr std::string_view getColorName(Color color)
 {
-    switch (color)
-    {
-    case black: return "black";
-    case red:   return "red";
-    case blue:  return "blue";
-    default:    return "???";
-    }
+    return colorNames.name(color);
 }
 
 // Teach operator<< how to print a Color
@@ -57,26 +56,17 @@ enum Pet
     whale, // 3
 };
 
+constexpr auto petNames{ makeEnumNames<Pet>("cat", "dog", "pig", "whale") };
+
 constexpr std::string_view getPetName(Pet pet)
 {
-    switch (pet)
-    {
-    case cat:   return "cat";
-    case dog:   return "dog";
-    case pig:   return "pig";
-    case whale: return "whale";
-    default:    return "???";
-    }
+    return petNames.name(pet);
 }
 
+// Instead of comparing sv against every name in turn, hash it to the only name it could be
 constexpr std::optional<Pet> getPetFromString(std::string_view sv)
 {
-    if (sv == "cat")   return cat;
-    if (sv == "dog")   return dog;
-    if (sv == "pig")   return pig;
-    if (sv == "whale") return whale;
-
-    return {};
+    return petNames.parse(sv);
 }
 
 // pet is an in/out parameter
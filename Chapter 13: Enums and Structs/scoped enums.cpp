@@ -23,8 +23,11 @@ Scoped Enumerations
 #define FAILURE 0
 
 #include <iostream>
+#include <string_view>
 #include <type_traits>
 
+#include "enumtable.h"
+
 
 /// Quiz
 enum class Animal {
@@ -36,29 +39,11 @@ enum class Animal {
     duck,
 };
 
-std::string_view getAnimalName(Animal a) {
-    switch(a) {
-        case Animal::pig:
-            return "pig";
-
-        case Animal::chicken:
-            return "chicken";
-
-        case Animal::goat:
-            return "goat";
+// names in enumerator order (see enumtable.h)
+constexpr auto animalNames{ makeEnumNames<Animal>("pig", "chicken", "goat", "cat", "dog", "duck") };
 
-        case Animal::cat:
-            return "cat";
-
-        case Animal::dog:
-            return "dog";
-        
-        case Animal::duck:
-            return "duck";
-        
-        default:
-            return "";
-    }
+constexpr std::string_view getAnimalName(Animal a) {
+    return animalNames.name(a, "");
 }
 
 void printNumberOfLegs(Animal a) {
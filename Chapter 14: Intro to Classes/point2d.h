@@ -0,0 +1,34 @@
+#ifndef POINT2D_H
+#define POINT2D_H
+
+#include <cmath>
+#include <iostream>
+
+// Point2d from the chapter quiz, moved into a header so other programs (e.g. the spatial grid in
+// "Chapter 15: More Classes/chapter quiz/spatialgrid.h") can use it too
+class Point2d {
+    private:
+        double m_x {0.0};
+        double m_y {0.0};
+    public:
+        Point2d() = default;
+        Point2d(double x, double y):  m_x {x}, m_y {y} {}
+
+        double getX() const { return m_x; }
+        double getY() const { return m_y; }
+
+        void print() const {
+            std::cout << "Point2d(" << m_x << ", " << m_y << ")\n";
+        }
+
+        // The squared distance is enough for comparing distances (closer, within a radius, ...) and needs no sqrt
+        double distanceSquaredTo(Point2d p2) const {
+            return (m_x - p2.m_x)*(m_x - p2.m_x) + (m_y - p2.m_y)*(m_y - p2.m_y);
+        }
+
+        double distanceTo(Point2d p2) const {
+            return std::sqrt(distanceSquaredTo(p2));
+        }
+};
+
+#endif
@@ -0,0 +1,92 @@
+/*
+Dice Throughput
+    Rolls an XdY+Z expression many times with Dice::roll (into a buffer) and Dice::histogram (no buffer at all),
+    compares them with the one-at-a-time std::uniform_int_distribution loop from "mersenne twister.cpp",
+    and prints the histogram of totals.
+    Passing an output file also times Dice::print, the buffered text dump.
+
+    Build: g++ -std=c++20 -O3 -march=native -pthread dice.cpp
+    Usage: ./a.out [expression] [rolls] [threads] [dump file]
+    Sample: ./a.out 3d6 100000000
+*/
+
+#include "../dice.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string text{ argc > 1 ? argv[1] : "3d6" };
+    const std::uint64_t rolls{ argc > 2 ? std::stoull(argv[2]) : 100'000'000 };
+    const unsigned int threads{ argc > 3 ? static_cast<unsigned int>(std::stoul(argv[3])) : std::max(1u, std::thread::hardware_concurrency()) };
+
+    const std::optional<Dice::Expression> expression{ Dice::parse(text) };
+    if (!expression)
+    {
+        std::cerr << "Couldn't parse \"" << text << "\", expected something like 3d6 or 2d8+1\n";
+        return 1;
+    }
+
+    constexpr std::uint64_t seed{ 1234 };
+    std::cout << text << ", " << rolls << " rolls, " << threads << " threads\n";
+
+    // the old way: one distribution call per die
+    std::vector<int> buffer(rolls);
+    const double serial{ secondsFor([&] {
+        std::mt19937 mt{ static_cast<std::mt19937::result_type>(seed) };
+        std::uniform_int_distribution die{ 1, expression->sides };
+        for (int& roll : buffer)
+        {
+            int total{ expression->modifier };
+            for (int d{ 0 }; d < expression->count; ++d)
+                total += die(mt);
+            roll = total;
+        }
+    }) };
+    std::cout << "uniform_int_distribution loop\t" << static_cast<double>(rolls) / serial / 1e6 << " M rolls/s\n";
+
+    const double buffered{ secondsFor([&] { Dice::roll(*expression, buffer, seed, threads); }) };
+    std::cout << "Dice::roll\t\t\t" << static_cast<double>(rolls) / buffered / 1e6 << " M rolls/s\n";
+
+    std::vector<std::uint64_t> counts{};
+    const double histogrammed{ secondsFor([&] { counts = Dice::histogram(*expression, rolls, seed, threads); }) };
+    std::cout << "Dice::histogram\t\t\t" << static_cast<double>(rolls) / histogrammed / 1e6 << " M rolls/s\n";
+    if (counts.empty())
+    {
+        std::cout << text << " has more than " << Dice::maxHistogramCounters << " possible totals, so there's no histogram\n";
+        return 0;
+    }
+
+    // same seed, so the histogram has to match the buffer exactly
+    std::vector<std::uint64_t> fromBuffer(counts.size());
+    for (int roll : buffer)
+        ++fromBuffer[static_cast<std::size_t>(roll - expression->min())];
+    std::cout << "histogram matches buffer: " << (fromBuffer == counts ? "yes" : "NO") << "\n\n";
+
+    for (std::size_t i{ 0 }; i < counts.size(); ++i)
+        std::cout << expression->min() + static_cast<int>(i) << '\t' << static_cast<double>(counts[i]) / static_cast<double>(rolls) << '\n';
+
+    if (argc > 4)
+    {
+        std::ofstream file{ argv[4], std::ios::binary };
+        const double dumped{ secondsFor([&] { Dice::print(buffer, file); }) };
+        std::cout << "\nDice::print to " << argv[4] << "\t" << static_cast<double>(rolls) / dumped / 1e6 << " M rolls/s\n";
+    }
+
+    return fromBuffer == counts ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+/*
+Monster Allocations
+    The quiz version of Monster held its name and roar as std::strings, copied out of the string_views that
+    MonsterGenerator::getName and getRoar return. Most fit in the small string buffer, but "Destroyer of Worlds" and
+    "you will soon crave the sweet release of death" don't, so on average a monster cost 1/3 of a heap allocation on creation
+    (and as many again on every copy).
+
+    Monster (../monster.h) now holds interned ids into Monster::strings(), so generating and copying monsters never allocates.
+    This counts allocations per monster (by replacing the global operator new) for the old layout, kept here as LegacyMonster,
+    and for the current one, along with the time per monster.
+
+    Build: g++ -std=c++20 -O2 "monster allocations.cpp"
+    Usage: ./a.out [monsters]
+*/
+
+#include "../monster.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::size_t g_allocations{ 0 };
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* p{ std::malloc(size) })
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Monster as the quiz wrote it: the strings are copied into every object
+struct LegacyMonster
+{
+    Monster::Type type{};
+    std::string name{ "???" };
+    std::string roar{ "???" };
+    int hitpoints{};
+};
+
+LegacyMonster generateLegacy()
+{
+    return LegacyMonster{ static_cast<Monster::Type>(Random::get<0, Monster::maxMonsterTypes - 1>()),
+                          std::string{ MonsterGenerator::getName(Random::get<0, MonsterGenerator::nameCount - 1>()) },
+                          std::string{ MonsterGenerator::getRoar(Random::get<0, MonsterGenerator::roarCount - 1>()) },
+                          Random::get<1, 100>() };
+}
+
+// Generates count monsters into a reserved vector, then copies the vector once.
+// Prints allocations per monster for each step (the reserves themselves are not counted).
+template <typename Generate>
+void measure(const char* name, std::size_t count, Generate generate)
+{
+    using T = decltype(generate());
+    std::vector<T> monsters{};
+    monsters.reserve(count);
+    std::vector<T> copies{};
+    copies.reserve(count);
+
+    const std::size_t before{ g_allocations };
+    const auto start{ std::chrono::steady_clock::now() };
+    for (std::size_t i{ 0 }; i < count; ++i)
+        monsters.push_back(generate());
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+    const std::size_t generated{ g_allocations - before };
+
+    copies.insert(copies.end(), monsters.begin(), monsters.end());
+    const std::size_t copied{ g_allocations - before - generated };
+
+    const double n{ static_cast<double>(count) };
+    std::cout << name << '\t' << sizeof(T) << '\t' << static_cast<double>(generated) / n << '\t'
+              << static_cast<double>(copied) / n << '\t' << elapsed.count() / n * 1e9 << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 2'000'000 };
+
+    // intern the generator's names and roars before counting, like a program would at startup
+    MonsterGenerator::generate();
+
+    std::cout << "monster\tbytes\tallocations/monster (generate)\tallocations/monster (copy)\tns/monster\n";
+    measure("LegacyMonster", count, generateLegacy);
+    measure("Monster", count, MonsterGenerator::generate);
+
+    return 0;
+}
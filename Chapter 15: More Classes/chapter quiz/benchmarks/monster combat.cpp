@@ -0,0 +1,116 @@
+/*
+Monster Combat
+    Runs rounds of combat (../combat.h) on a MonsterPool: each round every monster takes 1 to 10 damage,
+    deaths are found with batched mask compares, and the dead are compacted out of the pool in place.
+    Reports rounds per second at 1M and 10M monsters (or the sizes given) for
+    * Combat::Battle, which only compacts once the dead make up an eighth of the pool
+    * applyDamage + removeDead every round
+    * a one-monster-at-a-time loop (with a branch per monster) followed by MonsterPool::eraseDead every round
+    The damage rolls are timed separately. The last two give the same pool every round, which is checked,
+    and the pools are checked never to reallocate.
+
+    Build: g++ -std=c++20 -O3 -march=native "monster combat.cpp"
+    (without -mavx2 or -march=native the batches use SSE2)
+    Usage: ./a.out [rounds] [monsters...]
+*/
+
+#include "../combat.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+// The straightforward version: check every monster with a branch, then erase the dead
+std::size_t simpleRound(MonsterPool& pool, std::span<const int> damage)
+{
+    const std::span<int> hitpoints{ pool.hitpoints() };
+    std::size_t deaths{ 0 };
+    for (std::size_t i{ 0 }; i < hitpoints.size(); ++i)
+    {
+        hitpoints[i] -= damage[i];
+        if (hitpoints[i] <= 0)
+            ++deaths;
+    }
+    if (deaths > 0)
+        pool.eraseDead();
+    return deaths;
+}
+
+void run(std::size_t count, int rounds)
+{
+    MonsterPool battlePool{};
+    battlePool.reserve(count);
+    battlePool.generate(count, 42);
+    MonsterPool everyRound{ battlePool };
+    MonsterPool simple{ battlePool };
+
+    const int* storage[]{ battlePool.hitpoints().data(), everyRound.hitpoints().data(), simple.hitpoints().data() };
+    std::vector<int> damage(count);
+
+    Combat::Battle battle{ battlePool };
+    double rollSeconds{ 0.0 };
+    double battleSeconds{ 0.0 };
+    double everyRoundSeconds{ 0.0 };
+    double simpleSeconds{ 0.0 };
+    std::size_t deaths{ 0 };
+    bool same{ true };
+
+    for (int round{ 0 }; round < rounds; ++round)
+    {
+        rollSeconds += secondsFor([&] { Random::fill(std::span{ damage }, 1, 10); });
+
+        battleSeconds += secondsFor([&] { deaths += battle.round(std::span{ damage }.first(battlePool.size())); });
+
+        std::size_t died{};
+        everyRoundSeconds += secondsFor([&] {
+            died = Combat::applyDamage(everyRound.hitpoints(), damage);
+            if (died > 0)
+                Combat::removeDead(everyRound);
+        });
+
+        std::size_t simpleDied{};
+        simpleSeconds += secondsFor([&] { simpleDied = simpleRound(simple, damage); });
+
+        same = same && died == simpleDied && std::ranges::equal(everyRound.hitpoints(), simple.hitpoints());
+    }
+    battle.removeDead();
+
+    const bool inPlace{ (battlePool.empty() || battlePool.hitpoints().data() == storage[0])
+                        && (everyRound.empty() || everyRound.hitpoints().data() == storage[1])
+                        && (simple.empty() || simple.hitpoints().data() == storage[2]) };
+    const bool battleConsistent{ battlePool.size() == count - deaths && Combat::countDead(battlePool.hitpoints()) == 0 };
+
+    std::cout << count << '\t' << rounds / battleSeconds << '\t' << rounds / everyRoundSeconds << '\t'
+              << rounds / simpleSeconds << '\t' << rounds / rollSeconds << '\t' << deaths << '\t'
+              << (same && battleConsistent ? "yes" : "NO") << '\t' << (inPlace ? "yes" : "NO") << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    const int rounds{ argc > 1 ? std::stoi(argv[1]) : 30 };
+    std::vector<std::size_t> sizes{};
+    for (int i{ 2 }; i < argc; ++i)
+        sizes.push_back(std::stoull(argv[i]));
+    if (sizes.empty())
+        sizes = { 1'000'000, 10'000'000 };
+
+    std::cout << "monsters\trounds/s (Battle)\trounds/s (compact every round)\trounds/s (simple loop)\t"
+                 "damage rolls/s\tdeaths (Battle)\tchecks pass\tno reallocation\n";
+    for (std::size_t count : sizes)
+        run(count, rounds);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*
+Monster Spatial Grid
+    Places 1M monsters (or the number given) at random in a square world and compares SpatialGrid (../spatialgrid.h)
+    with scanning every monster using Point2d::distanceTo:
+    * building the grid, and moving every monster a short random step (incremental updates)
+    * radius queries ("everything within 100 units of the player")
+    * k-nearest queries ("the 10 closest monsters")
+    The grid's answers are checked against the scans.
+
+    Build: g++ -std=c++20 -O2 "monster grid.cpp"
+    Usage: ./a.out [monsters] [world size] [cell size]
+*/
+
+#include "../random.h"
+#include "../spatialgrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 1'000'000 };
+    const double worldSize{ argc > 2 ? std::stod(argv[2]) : 10'000.0 };
+    const double cellSize{ argc > 3 ? std::stod(argv[3]) : 50.0 };
+    constexpr double radius{ 100.0 };
+    const std::size_t k{ std::min<std::size_t>(10, count) };
+    constexpr int queries{ 1'000 };
+    constexpr int scans{ 20 }; // the O(n) scans are slow, so only run a few of them
+    if (count == 0)
+        return 0;
+
+    std::vector<double> coordinates(2 * count);
+    Random::fill(std::span{ coordinates }, 0.0, worldSize);
+    std::vector<Point2d> positions(count);
+    for (std::size_t i{ 0 }; i < count; ++i)
+        positions[i] = Point2d{ coordinates[2 * i], coordinates[2 * i + 1] };
+
+    std::vector<double> playerCoordinates(2 * queries);
+    Random::fill(std::span{ playerCoordinates }, 0.0, worldSize);
+    std::vector<Point2d> players(queries);
+    for (std::size_t i{ 0 }; i < players.size(); ++i)
+        players[i] = Point2d{ playerCoordinates[2 * i], playerCoordinates[2 * i + 1] };
+
+    SpatialGrid grid{ worldSize, worldSize, cellSize };
+    const double buildSeconds{ secondsFor([&] {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            grid.insert(static_cast<SpatialGrid::Id>(i), positions[i]);
+    }) };
+
+    std::vector<double> steps(2 * count);
+    Random::fill(std::span{ steps }, -5.0, 5.0);
+    for (std::size_t i{ 0 }; i < count; ++i)
+        positions[i] = Point2d{ positions[i].getX() + steps[2 * i], positions[i].getY() + steps[2 * i + 1] };
+    const double moveSeconds{ secondsFor([&] {
+        for (std::size_t i{ 0 }; i < count; ++i)
+            grid.move(static_cast<SpatialGrid::Id>(i), positions[i]);
+    }) };
+
+    // radius queries
+    std::size_t gridFound{ 0 };
+    const double radiusSeconds{ secondsFor([&] {
+        for (const Point2d& player : players)
+            grid.forEachWithinRadius(player, radius, [&gridFound](SpatialGrid::Id, double) { ++gridFound; });
+    }) };
+
+    bool same{ true };
+    const double radiusScanSeconds{ secondsFor([&] {
+        for (int q{ 0 }; q < scans; ++q)
+        {
+            std::vector<SpatialGrid::Id> scanned{};
+            for (std::size_t i{ 0 }; i < count; ++i)
+                if (positions[i].distanceTo(players[static_cast<std::size_t>(q)]) <= radius)
+                    scanned.push_back(static_cast<SpatialGrid::Id>(i));
+
+            std::vector<SpatialGrid::Id> found{ grid.withinRadius(players[static_cast<std::size_t>(q)], radius) };
+            std::sort(found.begin(), found.end());
+            same = same && found == scanned;
+        }
+    }) };
+
+    // k-nearest queries
+    double nearestTotal{ 0.0 };
+    const double nearestSeconds{ secondsFor([&] {
+        for (const Point2d& player : players)
+            nearestTotal += grid.nearest(player, k).back().distanceSquared;
+    }) };
+
+    const double nearestScanSeconds{ secondsFor([&] {
+        for (int q{ 0 }; q < scans; ++q)
+        {
+            const Point2d player{ players[static_cast<std::size_t>(q)] };
+            std::vector<double> distances(count);
+            for (std::size_t i{ 0 }; i < count; ++i)
+                distances[i] = positions[i].distanceTo(player);
+            std::partial_sort(distances.begin(), distances.begin() + static_cast<std::ptrdiff_t>(k), distances.end());
+
+            const std::vector<SpatialGrid::Hit> hits{ grid.nearest(player, k) };
+            for (std::size_t j{ 0 }; j < k; ++j)
+                same = same && std::abs(std::sqrt(hits[j].distanceSquared) - distances[j]) < 1e-9;
+        }
+    }) };
+
+    const double n{ static_cast<double>(count) };
+    std::cout << "monsters\t" << count << "\tcell size\t" << cellSize << '\n';
+    std::cout << "insert (monsters/s)\t" << n / buildSeconds << '\n';
+    std::cout << "move (monsters/s)\t" << n / moveSeconds << '\n';
+    std::cout << "radius " << radius << " queries/s\tgrid " << queries / radiusSeconds << "\tscan " << scans / radiusScanSeconds
+              << "\t(" << static_cast<double>(gridFound) / queries << " found per query)\n";
+    std::cout << k << "-nearest queries/s\tgrid " << queries / nearestSeconds << "\tscan " << scans / nearestScanSeconds << '\n';
+    std::cout << "grid matches scans: " << (same ? "yes" : "NO") << "\t(" << nearestTotal << ")\n";
+
+    return 0;
+}
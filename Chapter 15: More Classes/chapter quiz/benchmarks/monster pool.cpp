@@ -0,0 +1,117 @@
+/*
+MonsterPool vs std::vector<Monster>
+    A Monster is a Type, two interned string ids and an int, so std::vector<Monster> stores 16 bytes per monster.
+    MonsterPool (../monsterpool.h) stores the same information as four columns: 1+1+1+4 = 7 bytes per monster.
+
+    For each container this measures
+    * heap memory used, counted by replacing the global operator new
+    * creating N random monsters
+    * a scan that sums every monster's hitpoints (only the hitpoints column for MonsterPool)
+    * erasing every monster with 50 hitpoints or fewer
+
+    Build: g++ -std=c++20 -O2 "monster pool.cpp"
+    Usage: ./a.out [monsters]
+*/
+
+#include "../monsterpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// Every allocation in the program goes through here, so the benchmark can tell how many bytes a container owns
+static std::size_t g_allocatedBytes{ 0 };
+
+void* operator new(std::size_t size)
+{
+    g_allocatedBytes += size;
+    if (void* p{ std::malloc(size) })
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template <typename Function>
+double secondsFor(Function fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+    return elapsed.count();
+}
+
+void report(const char* name, std::size_t count, std::size_t bytes, double create, double scan, double erase, std::int64_t total, std::size_t left)
+{
+    const double n{ static_cast<double>(count) };
+    std::cout << name << '\t' << static_cast<double>(bytes) / n << '\t' << n / create << '\t' << n / scan << '\t' << n / erase
+              << "\t(sum " << total << ", " << left << " left)\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 5'000'000 };
+
+    std::cout << "container\tbytes/monster\tcreated/s\tscanned/s\terased/s\n";
+
+    {
+        std::vector<Monster> monsters{};
+        std::int64_t total{ 0 };
+
+        const std::size_t before{ g_allocatedBytes };
+        const double create{ secondsFor([&] {
+            monsters.reserve(count);
+            for (std::size_t i{ 0 }; i < count; ++i)
+                monsters.push_back(MonsterGenerator::generate());
+        }) };
+        const std::size_t bytes{ g_allocatedBytes - before };
+
+        const double scan{ secondsFor([&] {
+            for (const Monster& monster : monsters)
+                total += monster.getHitpoints();
+        }) };
+
+        const double erase{ secondsFor([&] {
+            std::erase_if(monsters, [](const Monster& monster) { return monster.getHitpoints() <= 50; });
+        }) };
+
+        report("vector<Monster>", count, bytes, create, scan, erase, total, monsters.size());
+    }
+
+    {
+        MonsterPool pool{};
+        std::int64_t total{ 0 };
+
+        const std::size_t before{ g_allocatedBytes };
+        const double create{ secondsFor([&] {
+            pool.reserve(count);
+            pool.generate(count);
+        }) };
+        const std::size_t bytes{ g_allocatedBytes - before };
+
+        const double scan{ secondsFor([&] {
+            for (int hitpoints : pool.hitpoints())
+                total += hitpoints;
+        }) };
+
+        const double erase{ secondsFor([&] {
+            const auto hitpoints{ pool.hitpoints() };
+            pool.eraseIf([hitpoints](std::size_t i) { return hitpoints[i] <= 50; });
+        }) };
+
+        report("MonsterPool", count, bytes, create, scan, erase, total, pool.size());
+
+        // the pool can still hand out ordinary monsters
+        if (!pool.empty())
+            pool.toMonster(0).print();
+    }
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+Monster Population
+    Times MonsterGenerator::generatePopulation (../monster.h) on 1, 2, 4, ... threads, filling one preallocated buffer,
+    against a serial loop over MonsterGenerator::generate(), and MonsterPool::generate(count, seed) for the same seed.
+    Every run is checked against the single-threaded one: the population must be identical whatever the thread count,
+    and the MonsterPool columns must hold the same monsters.
+
+    Build: g++ -std=c++20 -O3 -march=native -pthread "monster population.cpp"
+    Usage: ./a.out [monsters] [max threads] [seed]
+*/
+
+#include "../monsterpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 20'000'000 };
+    const unsigned int maxThreads{ argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2]))
+                                            : std::max(1u, std::thread::hardware_concurrency()) };
+    const std::uint64_t seed{ argc > 3 ? std::stoull(argv[3]) : 2024 };
+
+    std::vector<Monster> monsters(count);
+
+    const double serial{ secondsFor([&] {
+        for (Monster& monster : monsters)
+            monster = MonsterGenerator::generate();
+    }) };
+
+    std::cout << "method\tthreads\tmonsters/s\tsame as 1 thread\n";
+    std::cout << "generate() loop\t1\t" << static_cast<double>(count) / serial << "\t-\n";
+
+    std::vector<unsigned int> threadCounts{};
+    for (unsigned int threads{ 1 }; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::vector<Monster> reference{};
+    for (unsigned int threads : threadCounts)
+    {
+        const double seconds{ secondsFor([&] { MonsterGenerator::generatePopulation(std::span{ monsters }, seed, threads); }) };
+
+        if (reference.empty())
+            reference = monsters;
+        const bool same{ monsters == reference };
+
+        std::cout << "generatePopulation\t" << threads << '\t' << static_cast<double>(count) / seconds << '\t'
+                  << (same ? "yes" : "NO") << '\n';
+    }
+
+    MonsterPool pool{};
+    pool.reserve(count);
+    const double poolSeconds{ secondsFor([&] { pool.generate(count, seed, maxThreads); }) };
+
+    bool same{ pool.size() == reference.size() };
+    for (std::size_t i{ 0 }; same && i < pool.size(); ++i)
+        same = pool.toMonster(i) == reference[i];
+
+    std::cout << "MonsterPool::generate\t" << maxThreads << '\t' << static_cast<double>(count) / poolSeconds << '\t'
+              << (same ? "yes" : "NO") << '\n';
+
+    if (!reference.empty())
+        reference.front().print();
+
+    return 0;
+}
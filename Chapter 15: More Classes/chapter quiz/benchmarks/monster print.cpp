@@ -0,0 +1,96 @@
+/*
+Monster Printing
+    Dumps a population of monsters as text two ways:
+    * Monster::print() for each monster (with std::cout redirected into the destination)
+    * MonsterFormatter (../monsterformat.h), which renders everything into one buffer and writes it once
+    and checks that both produce exactly the same bytes. It also formats the same population from a MonsterPool.
+    Each dump is repeated a few times and the best time is reported, so the formatter's buffer has been reused.
+    The output goes to memory by default, or to a file if one is given.
+
+    Build: g++ -std=c++20 -O2 -pthread "monster print.cpp"
+    Usage: ./a.out [monsters] [output file]
+*/
+
+#include "../monsterformat.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Runs dump (which writes to the stream it's given) repeats times into a fresh destination and returns
+// the best time and the text of the last run
+template <typename Dump>
+std::pair<double, std::string> bestOf(int repeats, const std::string& path, Dump dump)
+{
+    double best{ 1e300 };
+    for (int i{ 0 }; i < repeats; ++i)
+    {
+        std::ostringstream memory{};
+        std::ofstream file{};
+        if (!path.empty())
+            file.open(path, std::ios::binary);
+        std::ostream& out{ path.empty() ? static_cast<std::ostream&>(memory) : file };
+
+        const auto start{ std::chrono::steady_clock::now() };
+        dump(out);
+        out.flush();
+        best = std::min(best, std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count());
+
+        if (i + 1 == repeats)
+        {
+            if (path.empty())
+                return { best, std::move(memory).str() };
+
+            file.close();
+            std::ifstream in{ path, std::ios::binary };
+            std::ostringstream contents{};
+            contents << in.rdbuf();
+            return { best, std::move(contents).str() };
+        }
+    }
+    return { best, {} };
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 1'000'000 };
+    const std::string path{ argc > 2 ? argv[2] : "" };
+    constexpr int repeats{ 3 };
+
+    std::vector<Monster> monsters{ MonsterGenerator::generatePopulation(count, 17) };
+    monsters.push_back(Monster{}); // a default-constructed monster prints as "??? the dragon is dead."
+    monsters.push_back(Monster{ Monster::orc, "Grunt", "*snort*", 0 }); // and one with a name nobody generated
+    MonsterPool pool{};
+    pool.generate(count, 17);
+
+    // print() always writes to std::cout, so point std::cout at the destination while it runs
+    const auto [printSeconds, printed]{ bestOf(repeats, path, [&monsters](std::ostream& out) {
+        std::streambuf* const original{ std::cout.rdbuf(out.rdbuf()) };
+        for (const Monster& monster : monsters)
+            monster.print();
+        std::cout.rdbuf(original);
+    }) };
+
+    MonsterFormatter formatter{};
+    const auto [formatSeconds, formatted]{ bestOf(repeats, path, [&](std::ostream& out) { formatter.write(std::span{ monsters }, out); }) };
+    const auto [poolSeconds, fromPool]{ bestOf(repeats, path, [&](std::ostream& out) { formatter.write(pool, out); }) };
+
+    // the pool holds the same monsters as the vector, minus the two extra ones at the end
+    formatter.append(std::span{ monsters }.first(count));
+    const bool poolSame{ fromPool == formatter.text() };
+    formatter.clear();
+
+    const double n{ static_cast<double>(monsters.size()) };
+    std::cout << "method\tmonsters/s\n";
+    std::cout << "Monster::print\t" << n / printSeconds << '\n';
+    std::cout << "MonsterFormatter\t" << n / formatSeconds << '\n';
+    std::cout << "MonsterFormatter (pool)\t" << static_cast<double>(count) / poolSeconds << '\n';
+    std::cout << "byte-identical to print(): " << (printed == formatted ? "yes" : "NO") << ", pool: " << (poolSame ? "yes" : "NO") << '\n';
+
+    return 0;
+}
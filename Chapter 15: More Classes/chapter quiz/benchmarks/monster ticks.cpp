@@ -0,0 +1,113 @@
+/*
+Monster AI Ticks
+    Runs a made-up AI update for every monster of a population each tick, where the cost depends on the monster's type
+    (a dragon plans for 200 steps, a zombie for 2), on a TickScheduler (../scheduler.h):
+    * with a static partition (each thread gets an equal share of the monsters and nothing else)
+    * with work stealing
+    and on a single thread for reference.
+    The population is sorted by type, as if monsters had been spawned in waves, so the equal shares are far from equal work.
+    Reports tick latency percentiles for both, and checks that they compute the same thing.
+
+    Build: g++ -std=c++20 -O2 -pthread "monster ticks.cpp"
+    Usage: ./a.out [monsters] [ticks] [threads] [grain]
+*/
+
+#include "../monster.h"
+#include "../scheduler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// AI steps per tick for each Monster::Type
+constexpr std::array<int, Monster::maxMonsterTypes> thinkSteps{
+    200, // dragon
+    10,  // goblin
+    40,  // ogre
+    20,  // orc
+    5,   // skeleton
+    60,  // troll
+    100, // vampire
+    2,   // zombie
+};
+
+// Stands in for pathfinding, target selection, ...: a chain of dependent steps the compiler can't skip
+std::uint32_t think(const Monster& monster, std::uint32_t state)
+{
+    state ^= static_cast<std::uint32_t>(monster.getHitpoints());
+    for (int step{ 0 }; step < thinkSteps[monster.getType()]; ++step)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+    }
+    return state;
+}
+
+struct Percentiles
+{
+    double p50{};
+    double p90{};
+    double p99{};
+    double max{};
+};
+
+Percentiles percentiles(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    const auto at = [&samples](double p) { return samples[static_cast<std::size_t>(p * static_cast<double>(samples.size() - 1))]; };
+    return { at(0.50), at(0.90), at(0.99), samples.back() };
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 1'000'000 };
+    const int ticks{ argc > 2 ? std::stoi(argv[2]) : 50 };
+    const unsigned int threads{ argc > 3 ? static_cast<unsigned int>(std::stoul(argv[3])) : Parallel::defaultThreads() };
+    const std::size_t grain{ argc > 4 ? std::stoull(argv[4]) : 256 };
+
+    std::vector<Monster> monsters{ MonsterGenerator::generatePopulation(count, 7) };
+    std::sort(monsters.begin(), monsters.end(), [](const Monster& a, const Monster& b) { return a.getType() < b.getType(); });
+
+    TickScheduler scheduler{ threads };
+    std::vector<std::uint32_t> brains(count, 1);
+
+    TickScheduler oneThread{ 1 };
+
+    const auto runTicks = [&](TickScheduler& scheduler, TickScheduler::Mode mode) {
+        std::fill(brains.begin(), brains.end(), 1u);
+        std::vector<double> latencies{};
+        for (int tick{ 0 }; tick < ticks; ++tick)
+        {
+            const auto start{ std::chrono::steady_clock::now() };
+            scheduler.run(count, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i{ begin }; i < end; ++i)
+                    brains[i] = think(monsters[i], brains[i]);
+            }, grain, mode);
+            latencies.push_back(std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - start }.count());
+        }
+
+        std::uint64_t checksum{ 0 };
+        for (std::uint32_t brain : brains)
+            checksum = checksum * 31 + brain;
+        return std::pair{ percentiles(latencies), checksum };
+    };
+
+    const auto [serial, serialSum]{ runTicks(oneThread, TickScheduler::Mode::staticPartition) };
+    const auto [fixed, fixedSum]{ runTicks(scheduler, TickScheduler::Mode::staticPartition) };
+    const auto [stealing, stealingSum]{ runTicks(scheduler, TickScheduler::Mode::workStealing) };
+
+    std::cout << count << " monsters, " << scheduler.threads() << " threads, " << ticks << " ticks, grain " << grain << '\n';
+    std::cout << "tick latency (ms)\tp50\tp90\tp99\tmax\n";
+    std::cout << "one thread\t" << serial.p50 << '\t' << serial.p90 << '\t' << serial.p99 << '\t' << serial.max << '\n';
+    std::cout << "static partition\t" << fixed.p50 << '\t' << fixed.p90 << '\t' << fixed.p99 << '\t' << fixed.max << '\n';
+    std::cout << "work stealing\t" << stealing.p50 << '\t' << stealing.p90 << '\t' << stealing.p99 << '\t' << stealing.max << '\n';
+    std::cout << "same results: " << (fixedSum == serialSum && stealingSum == serialSum ? "yes" : "NO") << '\n';
+
+    return 0;
+}
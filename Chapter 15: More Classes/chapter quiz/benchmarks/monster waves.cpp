@@ -0,0 +1,133 @@
+/*
+Monster Waves
+    Each round a wave of TransientMonsters (../transientmonster.h) is spawned with made-up names ("Crusty of wave 12, #345"),
+    fights for a few turns (the dead are erased as they fall), and is thrown away at the end of the round.
+    The same rounds are run with the monsters and their strings allocated
+    * from the global heap (std::pmr::new_delete_resource, i.e. plain new and delete)
+    * from a RoundArena (../roundarena.h), released in one go at the end of each round
+    Reports heap allocations per round (by replacing the global operator new) and the time per round.
+
+    Build: g++ -std=c++20 -O2 "monster waves.cpp"
+    Usage: ./a.out [rounds] [monsters per wave]
+*/
+
+#include "../roundarena.h"
+#include "../transientmonster.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::size_t g_allocations{ 0 };
+
+void* operator new(std::size_t size)
+{
+    ++g_allocations;
+    if (void* p{ std::malloc(size) })
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// std::pmr::new_delete_resource() uses the aligned forms
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    ++g_allocations;
+    const auto align{ std::max(static_cast<std::size_t>(alignment), sizeof(void*)) };
+    if (void* p{ std::aligned_alloc(align, (size + align - 1) / align * align) })
+        return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+// Spawns a wave into wave (whose allocator decides where everything goes), fights it out, and returns how many survived.
+// Names are built in name, a scratch string reused from round to round, so only the monsters' own strings allocate.
+std::size_t playRound(std::pmr::vector<TransientMonster>& wave, int round, std::size_t size, std::string& name)
+{
+    for (std::size_t i{ 0 }; i < size; ++i)
+    {
+        // "<name> of wave <round>, #<i>"
+        char digits[24]{};
+        name = MonsterGenerator::getName(static_cast<int>(i % MonsterGenerator::nameCount));
+        name += " of wave ";
+        name.append(digits, std::to_chars(digits, digits + sizeof(digits), round).ptr);
+        name += ", #";
+        name.append(digits, std::to_chars(digits, digits + sizeof(digits), i).ptr);
+
+        wave.emplace_back(static_cast<Monster::Type>(i % Monster::maxMonsterTypes), name,
+                          MonsterGenerator::getRoar(static_cast<int>(i % MonsterGenerator::roarCount)), static_cast<int>(i % 100) + 1);
+    }
+
+    for (int turn{ 0 }; turn < 4; ++turn)
+    {
+        for (std::size_t i{ 0 }; i < wave.size(); ++i)
+            wave[i].takeDamage(static_cast<int>((i * 7 + static_cast<std::size_t>(turn) * 13) % 30));
+        std::erase_if(wave, [](const TransientMonster& monster) { return monster.getHitpoints() <= 0; });
+    }
+
+    return wave.size();
+}
+
+template <typename NextRound>
+void measure(const char* name, int rounds, NextRound nextRound)
+{
+    std::size_t survivors{ 0 };
+    const std::size_t before{ g_allocations };
+    const auto start{ std::chrono::steady_clock::now() };
+    for (int round{ 0 }; round < rounds; ++round)
+        survivors += nextRound(round);
+    const std::chrono::duration<double, std::micro> elapsed{ std::chrono::steady_clock::now() - start };
+
+    std::cout << name << '\t' << static_cast<double>(g_allocations - before) / rounds << '\t' << elapsed.count() / rounds
+              << "\t(" << survivors << " survivors)\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const int rounds{ argc > 1 ? std::stoi(argv[1]) : 200 };
+    const std::size_t waveSize{ argc > 2 ? std::stoull(argv[2]) : 10'000 };
+
+    std::cout << "allocator\tallocations/round\tus/round\n";
+
+    std::string scratch{};
+    scratch.reserve(64);
+
+    measure("global heap", rounds, [waveSize, &scratch](int round) {
+        std::pmr::vector<TransientMonster> wave{ std::pmr::new_delete_resource() };
+        return playRound(wave, round, waveSize, scratch);
+    });
+
+    // one practice round, so the arena has grown to fit a whole round before measuring
+    RoundArena arena{};
+    {
+        std::pmr::vector<TransientMonster> wave{ arena.resource() };
+        playRound(wave, 0, waveSize, scratch);
+    }
+    arena.endRound();
+
+    measure("RoundArena", rounds, [&arena, waveSize, &scratch](int round) {
+        std::size_t survivors{};
+        {
+            std::pmr::vector<TransientMonster> wave{ arena.resource() };
+            survivors = playRound(wave, round, waveSize, scratch);
+        } // the wave must be gone before its memory is
+        arena.endRound();
+        return survivors;
+    });
+
+    std::cout << "arena size: " << arena.capacity() << " bytes\n";
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+Bounded Integer Sampling
+    Random::get(min, max) used to construct a std::uniform_int_distribution for every call, which costs at least one division per draw.
+    It now uses Lemire's multiply-shift method, and Random::get<min, max>() also moves the rejection threshold to compile time.
+
+    This benchmark first checks that Random::get(1, 6) and Random::get<1, 6>() produce identical values from identical engine states,
+    then reports ns/value for:
+        std::uniform_int_distribution{ 1, 6 }(Random::mt)  (the old path)
+        Random::get(1, 6)                                   (runtime range)
+        Random::get<1, 6>()                                 (compile-time range)
+    and the same again for the wider range [0, 999'999].
+
+    Build: g++ -std=c++20 -O2 "random bounded.cpp"
+    Usage: ./a.out [draws]
+*/
+
+#include "../random.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+template <typename F>
+double nsPerCall(std::int64_t draws, F&& fn)
+{
+    std::int64_t sink{ 0 };
+    const auto start{ std::chrono::steady_clock::now() };
+    for (std::int64_t i{ 0 }; i < draws; ++i)
+        sink += fn();
+    const std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+
+    if (sink == 42) // use the result so the loop can't be optimized away
+        std::cout << "";
+    return elapsed.count() / static_cast<double>(draws);
+}
+
+// Returns true if the runtime and compile-time overloads agree on the next count values
+template <int min, int max>
+bool overloadsAgree(int count)
+{
+    const Random::Engine saved{ Random::engine() };
+
+    std::vector<int> runtime(static_cast<std::size_t>(count));
+    for (int& value : runtime)
+        value = Random::get(min, max);
+
+    Random::engine() = saved;
+    for (int value : runtime)
+        if (value != Random::get<min, max>())
+            return false;
+
+    return true;
+}
+
+template <int min, int max>
+void benchmarkRange(std::int64_t draws)
+{
+    // read the bounds through volatile so the runtime paths can't be specialized for the constant range
+    volatile int low{ min };
+    volatile int high{ max };
+
+    std::cout << "range [" << min << ", " << max << "]\n";
+    std::cout << "  uniform_int_distribution\t"
+              << nsPerCall(draws, [&] { return std::uniform_int_distribution{ low, high }(Random::mt); }) << " ns\n";
+    std::cout << "  Random::get(min, max)\t\t"
+              << nsPerCall(draws, [&] { return Random::get(low, high); }) << " ns\n";
+    std::cout << "  Random::get<min, max>()\t"
+              << nsPerCall(draws, [] { return Random::get<min, max>(); }) << " ns\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const std::int64_t draws{ argc > 1 ? std::stoll(argv[1]) : 100'000'000 };
+
+    const bool agree{ overloadsAgree<1, 6>(1'000'000) && overloadsAgree<0, 999'999>(1'000'000) };
+    std::cout << "runtime and compile-time ranges agree: " << (agree ? "yes" : "NO") << "\n\n";
+
+    benchmarkRange<1, 6>(draws);
+    benchmarkRange<0, 999'999>(draws);
+
+    return agree ? 0 : 1;
+}
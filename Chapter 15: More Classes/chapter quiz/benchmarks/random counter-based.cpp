@@ -0,0 +1,80 @@
+/*
+Counter-Based Parallel Fill
+    Random::at(seed, stream, index) is a pure function, so a parallel loop can hand any slice of a buffer to any thread
+    and every element still gets the same value. This benchmark fills a large buffer with Random::at on 1, 2, 4, ... N threads,
+    checks that every run produced exactly the same buffer as the single-threaded one, and reports throughput.
+
+    Build: g++ -std=c++20 -O3 -march=native -pthread "random counter-based.cpp"
+    Usage: ./a.out [values] [max threads]
+*/
+
+#include "../random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr std::uint64_t seed{ 0x5EED };
+constexpr std::uint64_t stream{ 0 };
+
+// Fills buffer[i] = Random::at(seed, stream, i), splitting the index range into one contiguous chunk per thread
+void parallelFill(std::span<std::uint64_t> buffer, unsigned int threads)
+{
+    std::vector<std::thread> workers{};
+    workers.reserve(threads);
+
+    const std::size_t chunk{ (buffer.size() + threads - 1) / threads };
+    for (unsigned int t{ 0 }; t < threads; ++t)
+    {
+        const std::size_t begin{ std::min(buffer.size(), t * chunk) };
+        const std::size_t end{ std::min(buffer.size(), begin + chunk) };
+
+        workers.emplace_back([buffer, begin, end] {
+            for (std::size_t i{ begin }; i < end; ++i)
+                buffer[i] = Random::at(seed, stream, i);
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 100'000'000 };
+    const unsigned int maxThreads{ argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2]))
+                                            : std::max(1u, std::thread::hardware_concurrency()) };
+
+    std::vector<std::uint64_t> reference(count);
+    std::vector<std::uint64_t> buffer(count);
+
+    std::vector<unsigned int> threadCounts{};
+    for (unsigned int threads{ 1 }; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::cout << "threads\tM values/s\tsame as 1 thread\n";
+
+    bool allMatch{ true };
+    for (unsigned int threads : threadCounts)
+    {
+        auto& target{ threads == 1 ? reference : buffer };
+
+        const auto start{ std::chrono::steady_clock::now() };
+        parallelFill(target, threads);
+        const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+        const bool match{ threads == 1 || buffer == reference };
+        allMatch = allMatch && match;
+
+        std::cout << threads << '\t' << static_cast<double>(count) / elapsed.count() / 1e6
+                  << "\t\t" << (match ? "yes" : "NO") << '\n';
+    }
+
+    return allMatch ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/*
+Normal and Exponential Distributions
+    Times Random::normal / Random::exponential (one value per call) and Random::fillNormal / Random::fillExponential
+    (a whole buffer per call) against std::normal_distribution and std::exponential_distribution on the same engine,
+    and prints the sample mean and variance of each as a sanity check.
+    Expected: normal(0, 1) has mean 0 and variance 1, exponential(2) has mean 0.5 and variance 0.25.
+
+    Build: g++ -std=c++20 -O2 "random distributions.cpp"
+    Usage: ./a.out [values]
+*/
+
+#include "../random.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+template <typename F>
+double nsPerValue(std::size_t count, F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    const std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+    return elapsed.count() / static_cast<double>(count);
+}
+
+void report(std::string_view name, double ns, const std::vector<double>& values)
+{
+    double sum{ 0.0 };
+    double sumSquares{ 0.0 };
+    for (double v : values)
+    {
+        sum += v;
+        sumSquares += v * v;
+    }
+    const double n{ static_cast<double>(values.size()) };
+    const double mean{ sum / n };
+
+    std::cout << std::left << std::setw(30) << name << std::right << std::fixed
+              << std::setw(10) << std::setprecision(2) << ns
+              << std::setw(12) << std::setprecision(4) << mean
+              << std::setw(12) << sumSquares / n - mean * mean << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 20'000'000 };
+    std::vector<double> values(count);
+
+    std::cout << std::left << std::setw(30) << "distribution" << std::right
+              << std::setw(10) << "ns/value" << std::setw(12) << "mean" << std::setw(12) << "variance" << '\n';
+
+    std::normal_distribution<double> normal{ 0.0, 1.0 };
+    double ns{ nsPerValue(count, [&] { for (double& v : values) v = normal(Random::engine()); }) };
+    report("std::normal_distribution", ns, values);
+
+    ns = nsPerValue(count, [&] { for (double& v : values) v = Random::normal(); });
+    report("Random::normal", ns, values);
+
+    ns = nsPerValue(count, [&] { Random::fillNormal(values); });
+    report("Random::fillNormal", ns, values);
+
+    std::exponential_distribution<double> exponential{ 2.0 };
+    ns = nsPerValue(count, [&] { for (double& v : values) v = exponential(Random::engine()); });
+    report("std::exponential_distribution", ns, values);
+
+    ns = nsPerValue(count, [&] { for (double& v : values) v = Random::exponential(2.0); });
+    report("Random::exponential", ns, values);
+
+    ns = nsPerValue(count, [&] { Random::fillExponential(values, 2.0); });
+    report("Random::fillExponential", ns, values);
+
+    return 0;
+}
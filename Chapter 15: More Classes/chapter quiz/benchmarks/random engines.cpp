@@ -0,0 +1,70 @@
+/*
+Random Engine Comparison
+    Random::Engine can be switched at compile time with RANDOM_ENGINE, so we need numbers to pick one per workload.
+    For each engine this prints the size of its state, the cost of one raw draw (operator()),
+    and the cost of one Random::get-style draw through std::uniform_int_distribution{ 1, 6 }.
+
+    Smaller state leaves more of the L1 cache for everything else, which matters more in real programs than in this loop.
+
+    Build: g++ -std=c++20 -O2 "random engines.cpp"
+    Usage: ./a.out [draws]
+*/
+
+#include "../random.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+// Times draws calls of fn() and returns nanoseconds per call
+template <typename F>
+double nsPerCall(std::int64_t draws, F&& fn)
+{
+    std::uint64_t sink{ 0 };
+    const auto start{ std::chrono::steady_clock::now() };
+    for (std::int64_t i{ 0 }; i < draws; ++i)
+        sink += fn();
+    const std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+
+    // use the result so the loop can't be optimized away
+    if (sink == 42)
+        std::cout << "";
+    return elapsed.count() / static_cast<double>(draws);
+}
+
+template <typename E>
+void benchmarkEngine(std::string_view name, std::int64_t draws)
+{
+    E engine{ Random::generate<E>() };
+    std::uniform_int_distribution die6{ 1, 6 };
+
+    const double raw{ nsPerCall(draws, [&] { return static_cast<std::uint64_t>(engine()); }) };
+    const double dice{ nsPerCall(draws, [&] { return static_cast<std::uint64_t>(die6(engine)); }) };
+
+    std::cout << std::left << std::setw(22) << name
+              << std::right << std::setw(8) << sizeof(E) << " B"
+              << std::setw(12) << std::fixed << std::setprecision(2) << raw
+              << std::setw(14) << dice << '\n';
+}
+
+int main(int argc, char* argv[])
+{
+    const std::int64_t draws{ argc > 1 ? std::stoll(argv[1]) : 100'000'000 };
+
+    std::cout << std::left << std::setw(22) << "engine"
+              << std::right << std::setw(10) << "state"
+              << std::setw(12) << "ns/value"
+              << std::setw(14) << "ns/die roll" << '\n';
+
+    benchmarkEngine<std::mt19937>("std::mt19937", draws);
+    benchmarkEngine<Random::Pcg32>("Random::Pcg32", draws);
+    benchmarkEngine<Random::Xoshiro256ss>("Random::Xoshiro256ss", draws);
+    benchmarkEngine<Random::SplitMix64>("Random::SplitMix64", draws);
+    benchmarkEngine<Random::Lcg16>("Random::Lcg16", draws);
+
+    return 0;
+}
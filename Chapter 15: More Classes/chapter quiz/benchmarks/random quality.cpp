@@ -0,0 +1,372 @@
+/*
+Random Quality Tests
+    Speed is only half the story: a fast engine is useless if its output has patterns in it.
+    This harness streams samples from each generator through five classic statistical tests (see Knuth, TAOCP vol. 2, 3.3.2,
+    and Marsaglia's Diehard battery) without ever storing the samples, so it can run billions of them in constant memory.
+
+    chi-square      do the values land evenly in 256 equal buckets?
+    serial corr.    is each value correlated with the one before it?
+    runs            do values above and below 0.5 alternate as often as they should?
+    gap             are the gaps between values falling in [0, 0.1) geometrically distributed?
+    birthday        when 512 "birthdays" are picked from 2^24 days, do repeated spacings between them follow a Poisson(2) law?
+
+    Each generator is run on every core at once, with every thread drawing from its own independently seeded stream
+    (Random::seeded(seed, thread)), and the per-thread tallies are merged at the end.
+    Each test reports a p-value: values very close to 0 (or 1, for "too good to be true") mean the generator failed.
+    Lcg16 from "intro to rng.cpp" is expected to fail several of these.
+
+    Run this before switching RANDOM_ENGINE to a new engine.
+
+    Build: g++ -std=c++20 -O2 -pthread "random quality.cpp"
+    Usage: ./a.out [samples per generator] [threads]
+*/
+
+#define RANDOM_PER_THREAD // so the Random::get source can run on several threads safely
+#include "../random.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+constexpr std::uint64_t seed{ 20240101 };
+
+constexpr int chiBuckets{ 256 };
+
+constexpr double gapLow{ 0.0 };
+constexpr double gapHigh{ 0.1 };
+constexpr int gapClasses{ 32 }; // gaps of 0..30, and 31 or longer
+
+constexpr int birthdays{ 512 };
+constexpr std::uint32_t birthdayDays{ 1u << 24 };
+constexpr double birthdayLambda{ static_cast<double>(birthdays) * birthdays * birthdays / (4.0 * birthdayDays) };
+constexpr int birthdayClasses{ 9 }; // 0..7 repeated spacings, and 8 or more
+
+// p-value helpers
+
+// Regularized upper incomplete gamma function Q(a, x), after Numerical Recipes 6.2
+double gammaQ(double a, double x)
+{
+    if (x <= 0.0)
+        return 1.0;
+
+    const double logPrefix{ a * std::log(x) - x - std::lgamma(a) };
+
+    if (x < a + 1.0)
+    {
+        // series for P(a, x)
+        double term{ 1.0 / a };
+        double sum{ term };
+        for (int n{ 1 }; n < 1000 && std::abs(term) > std::abs(sum) * 1e-15; ++n)
+        {
+            term *= x / (a + n);
+            sum += term;
+        }
+        return 1.0 - sum * std::exp(logPrefix);
+    }
+
+    // continued fraction for Q(a, x) (modified Lentz)
+    constexpr double tiny{ 1e-300 };
+    double b{ x + 1.0 - a };
+    double c{ 1.0 / tiny };
+    double d{ 1.0 / b };
+    double h{ d };
+    for (int i{ 1 }; i < 1000; ++i)
+    {
+        const double an{ -i * (i - a) };
+        b += 2.0;
+        d = an * d + b;
+        if (std::abs(d) < tiny)
+            d = tiny;
+        c = b + an / c;
+        if (std::abs(c) < tiny)
+            c = tiny;
+        d = 1.0 / d;
+        const double delta{ d * c };
+        h *= delta;
+        if (std::abs(delta - 1.0) < 1e-15)
+            break;
+    }
+    return std::exp(logPrefix) * h;
+}
+
+// Probability that a chi-square variable with df degrees of freedom is at least chiSquare
+double chiSquareP(double chiSquare, int df)
+{
+    return gammaQ(df / 2.0, chiSquare / 2.0);
+}
+
+// Two-sided p-value of a standard normal z-score
+double normalP(double z)
+{
+    return std::erfc(std::abs(z) / std::sqrt(2.0));
+}
+
+// Streaming tallies for one thread's stream of samples in [0, 1)
+struct Tallies
+{
+    std::uint64_t count{};
+
+    std::array<std::uint64_t, chiBuckets> buckets{};
+
+    double sum{};
+    double sumSquares{};
+    double sumLagProducts{};
+    double previous{};
+
+    std::uint64_t runs{};
+    std::uint64_t above{};
+    std::uint64_t below{};
+    bool previousAbove{};
+    double runsMean{};     // filled in by finish()
+    double runsVariance{}; // filled in by finish()
+
+    std::array<std::uint64_t, gapClasses> gaps{};
+    std::uint64_t currentGap{};
+
+    std::array<std::uint32_t, birthdays> days{};
+    int dayCount{};
+    std::array<std::uint64_t, birthdayClasses> repeatedSpacings{};
+
+    void add(double u)
+    {
+        ++buckets[static_cast<std::size_t>(u * chiBuckets)];
+
+        sum += u;
+        sumSquares += u * u;
+        if (count > 0)
+            sumLagProducts += previous * u;
+        previous = u;
+
+        const bool isAbove{ u >= 0.5 };
+        if (count == 0 || isAbove != previousAbove)
+            ++runs;
+        previousAbove = isAbove;
+        ++(isAbove ? above : below);
+
+        if (u >= gapLow && u < gapHigh)
+        {
+            ++gaps[std::min<std::uint64_t>(currentGap, gapClasses - 1)];
+            currentGap = 0;
+        }
+        else
+            ++currentGap;
+
+        days[static_cast<std::size_t>(dayCount++)] = static_cast<std::uint32_t>(u * birthdayDays);
+        if (dayCount == birthdays)
+            finishBirthdayBatch();
+
+        ++count;
+    }
+
+    void finishBirthdayBatch()
+    {
+        std::sort(days.begin(), days.end());
+
+        std::array<std::uint32_t, birthdays> spacings{};
+        spacings[0] = days[0];
+        for (std::size_t i{ 1 }; i < days.size(); ++i)
+            spacings[i] = days[i] - days[i - 1];
+        std::sort(spacings.begin(), spacings.end());
+
+        int repeats{ 0 };
+        for (std::size_t i{ 1 }; i < spacings.size(); ++i)
+            if (spacings[i] == spacings[i - 1])
+                ++repeats;
+
+        ++repeatedSpacings[static_cast<std::size_t>(std::min(repeats, birthdayClasses - 1))];
+        dayCount = 0;
+    }
+
+    // Works out the expected number of runs for this thread's stream (they can't be pooled until then)
+    void finish()
+    {
+        const double n{ static_cast<double>(above + below) };
+        if (above == 0 || below == 0)
+            return;
+        runsMean = 2.0 * static_cast<double>(above) * static_cast<double>(below) / n + 1.0;
+        runsVariance = (runsMean - 1.0) * (runsMean - 2.0) / (n - 1.0);
+    }
+
+    void merge(const Tallies& other)
+    {
+        count += other.count;
+        for (std::size_t i{ 0 }; i < buckets.size(); ++i)
+            buckets[i] += other.buckets[i];
+
+        sum += other.sum;
+        sumSquares += other.sumSquares;
+        sumLagProducts += other.sumLagProducts;
+
+        runs += other.runs;
+        above += other.above;
+        below += other.below;
+        runsMean += other.runsMean;
+        runsVariance += other.runsVariance;
+
+        for (std::size_t i{ 0 }; i < gaps.size(); ++i)
+            gaps[i] += other.gaps[i];
+        for (std::size_t i{ 0 }; i < repeatedSpacings.size(); ++i)
+            repeatedSpacings[i] += other.repeatedSpacings[i];
+    }
+};
+
+void printResult(std::string_view test, double statistic, double p)
+{
+    const bool failed{ p < 1e-3 || p > 1.0 - 1e-3 };
+    std::cout << "  " << std::left << std::setw(14) << test
+              << std::right << std::setw(14) << std::setprecision(6) << statistic
+              << std::setw(14) << p
+              << (failed ? "   FAIL" : "") << '\n';
+}
+
+void report(const Tallies& t, int threads)
+{
+    const double n{ static_cast<double>(t.count) };
+
+    // chi-square on equal buckets
+    const double expected{ n / chiBuckets };
+    double chi{ 0.0 };
+    for (std::uint64_t observed : t.buckets)
+        chi += (static_cast<double>(observed) - expected) * (static_cast<double>(observed) - expected) / expected;
+    printResult("chi-square", chi, chiSquareP(chi, chiBuckets - 1));
+
+    // lag-1 serial correlation, which is approximately normal with variance 1/pairs
+    const double pairs{ n - threads };
+    const double mean{ t.sum / n };
+    const double variance{ t.sumSquares / n - mean * mean };
+    const double correlation{ (t.sumLagProducts / pairs - mean * mean) / variance };
+    printResult("serial corr.", correlation, normalP(correlation * std::sqrt(pairs)));
+
+    // runs above/below 0.5
+    const double runsZ{ (static_cast<double>(t.runs) - t.runsMean) / std::sqrt(t.runsVariance) };
+    printResult("runs", runsZ, normalP(runsZ));
+
+    // gap lengths against the geometric distribution
+    const double p{ gapHigh - gapLow };
+    double totalGaps{ 0.0 };
+    for (std::uint64_t g : t.gaps)
+        totalGaps += static_cast<double>(g);
+    double gapChi{ 0.0 };
+    for (int r{ 0 }; r < gapClasses; ++r)
+    {
+        const double probability{ r < gapClasses - 1 ? p * std::pow(1.0 - p, r) : std::pow(1.0 - p, r) };
+        const double e{ totalGaps * probability };
+        const double o{ static_cast<double>(t.gaps[static_cast<std::size_t>(r)]) };
+        gapChi += (o - e) * (o - e) / e;
+    }
+    printResult("gap", gapChi, chiSquareP(gapChi, gapClasses - 1));
+
+    // repeated birthday spacings against Poisson(lambda)
+    double batches{ 0.0 };
+    for (std::uint64_t b : t.repeatedSpacings)
+        batches += static_cast<double>(b);
+    double birthdayChi{ 0.0 };
+    double tail{ 1.0 };
+    for (int k{ 0 }; k < birthdayClasses; ++k)
+    {
+        const double probability{ k < birthdayClasses - 1
+            ? std::exp(-birthdayLambda + k * std::log(birthdayLambda) - std::lgamma(k + 1.0))
+            : tail };
+        tail -= probability;
+        const double e{ batches * probability };
+        const double o{ static_cast<double>(t.repeatedSpacings[static_cast<std::size_t>(k)]) };
+        birthdayChi += (o - e) * (o - e) / e;
+    }
+    printResult("birthday", birthdayChi, chiSquareP(birthdayChi, birthdayClasses - 1));
+}
+
+// Runs every test on samples values from makeSource(thread)(), split across threads
+template <typename MakeSource>
+void testGenerator(std::string_view name, std::uint64_t samples, int threads, MakeSource makeSource)
+{
+    std::vector<Tallies> tallies(static_cast<std::size_t>(threads));
+    std::vector<std::thread> workers{};
+
+    const auto threadCount{ static_cast<std::uint64_t>(threads) };
+    const auto start{ std::chrono::steady_clock::now() };
+    for (int t{ 0 }; t < threads; ++t)
+    {
+        const std::uint64_t share{ samples / threadCount + (static_cast<std::uint64_t>(t) < samples % threadCount ? 1 : 0) };
+        workers.emplace_back([&tallies, &makeSource, t, share] {
+            auto source{ makeSource(static_cast<std::uint64_t>(t)) };
+            Tallies& mine{ tallies[static_cast<std::size_t>(t)] };
+            for (std::uint64_t i{ 0 }; i < share; ++i)
+                mine.add(source());
+            mine.finish();
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+    const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+    Tallies total{};
+    for (const Tallies& t : tallies)
+        total.merge(t);
+
+    std::cout << name << " (" << samples << " samples, " << std::setprecision(3) << elapsed.count() << " s)\n";
+    report(total, threads);
+}
+
+// Wraps an engine as a source of doubles in [0, 1)
+// Dividing a 64-bit value by 2^64 can round up to exactly 1.0, so wide engines keep only their top 53 bits
+// (every double of the form k / 2^53 is exact). Narrower ones are divided by their range, which is also exact.
+template <typename E>
+auto unitSource(E engine)
+{
+    return [engine]() mutable {
+        constexpr int bits{ std::bit_width(static_cast<std::uint64_t>(E::max() - E::min())) };
+        const auto value{ static_cast<std::uint64_t>(engine() - E::min()) };
+        if constexpr (bits > 53)
+            return static_cast<double>(value >> (bits - 53)) * 0x1.0p-53;
+        else
+            return static_cast<double>(value) / (static_cast<double>(E::max() - E::min()) + 1.0);
+    };
+}
+
+int main(int argc, char* argv[])
+{
+    const std::uint64_t samples{ argc > 1 ? std::stoull(argv[1]) : 1ull << 26 };
+    const int threads{ argc > 2 ? std::stoi(argv[2]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) };
+
+    std::cout << "  " << std::left << std::setw(14) << "test"
+              << std::right << std::setw(14) << "statistic"
+              << std::setw(14) << "p-value" << '\n';
+
+    testGenerator("Random::Lcg16 (intro to rng.cpp)", samples, threads,
+        [](std::uint64_t t) { return unitSource(Random::seeded<Random::Lcg16>(seed, t)); });
+
+    // the three seedings from "mersenne twister.cpp"
+    testGenerator("std::mt19937 (default seed + thread)", samples, threads,
+        [](std::uint64_t t) { return unitSource(std::mt19937{ static_cast<std::mt19937::result_type>(std::mt19937::default_seed + t) }); });
+    testGenerator("std::mt19937 (steady_clock seed)", samples, threads,
+        [](std::uint64_t t) {
+            return unitSource(std::mt19937{ static_cast<std::mt19937::result_type>(
+                std::chrono::steady_clock::now().time_since_epoch().count() + static_cast<long long>(t)) });
+        });
+    testGenerator("std::mt19937 (random_device seed)", samples, threads,
+        [](std::uint64_t) { return unitSource(std::mt19937{ std::random_device{}() }); });
+
+    testGenerator("Random::get (the global engine)", samples, threads,
+        [](std::uint64_t) { return [] { return Random::get(0, (1 << 30) - 1) * 0x1.0p-30; }; });
+
+    testGenerator("Random::Pcg32", samples, threads,
+        [](std::uint64_t t) { return unitSource(Random::seeded<Random::Pcg32>(seed, t)); });
+    testGenerator("Random::Xoshiro256ss", samples, threads,
+        [](std::uint64_t t) { return unitSource(Random::seeded<Random::Xoshiro256ss>(seed, t)); });
+    testGenerator("Random::SplitMix64", samples, threads,
+        [](std::uint64_t t) { return unitSource(Random::seeded<Random::SplitMix64>(seed, t)); });
+    testGenerator("Random::at (Philox4x32-10)", samples, threads,
+        [](std::uint64_t t) { return [t, i = std::uint64_t{ 0 }]() mutable { return Random::atUnit(seed, t, i++); }; });
+
+    return 0;
+}
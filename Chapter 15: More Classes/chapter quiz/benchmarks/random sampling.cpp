@@ -0,0 +1,95 @@
+/*
+Sampling and Shuffling
+    Compares the new sampling tools in sampling.h with the std::shuffle-based way of doing the same job:
+        Random::sample(k, n)       vs shuffling [0, n) and keeping the first k
+        Random::Reservoir<T>       vs storing the whole stream and then shuffling it
+        Random::parallelShuffle    vs std::shuffle(..., Random::mt)
+    and checks that the parallel shuffle really is a permutation (every element still there exactly once)
+    and gives the same result for the same seed with 1 thread and with all of them.
+
+    Build: g++ -std=c++20 -O2 -pthread "random sampling.cpp"
+    Usage: ./a.out [array size] [threads]        (try 100000000 with enough RAM: it needs about 3x the array)
+*/
+
+#include "../sampling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename F>
+double millisecondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double, std::milli>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t n{ argc > 1 ? std::stoull(argv[1]) : 20'000'000 };
+    const unsigned int threads{ argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2])) : Parallel::defaultThreads() };
+    constexpr std::size_t k{ 1000 };
+
+    std::cout << "n = " << n << ", k = " << k << ", " << threads << " threads\n\n";
+
+    // k out of n
+    std::vector<std::uint64_t> picked{};
+    double ms{ millisecondsFor([&] { picked = Random::sample(k, n); }) };
+    std::cout << "Random::sample(k, n)\t\t" << ms << " ms\n";
+
+    std::vector<std::uint32_t> values(n);
+    ms = millisecondsFor([&] {
+        std::iota(values.begin(), values.end(), 0u);
+        std::shuffle(values.begin(), values.end(), Random::mt);
+    });
+    std::cout << "iota + std::shuffle, keep k\t" << ms << " ms\n\n";
+
+    // k out of a stream
+    Random::Reservoir<std::uint64_t> reservoir{ k };
+    ms = millisecondsFor([&] {
+        for (std::uint64_t i{ 0 }; i < n; ++i)
+            reservoir.add(i);
+    });
+    std::cout << "Random::Reservoir (stream)\t" << ms << " ms, kept " << reservoir.items().size() << '\n';
+
+    ms = millisecondsFor([&] {
+        std::vector<std::uint64_t> stored{};
+        for (std::uint64_t i{ 0 }; i < n; ++i)
+            stored.push_back(i);
+        std::shuffle(stored.begin(), stored.end(), Random::mt);
+        stored.resize(k);
+    });
+    std::cout << "store all + std::shuffle\t" << ms << " ms\n\n";
+
+    // the whole array
+    std::iota(values.begin(), values.end(), 0u);
+    ms = millisecondsFor([&] { std::shuffle(values.begin(), values.end(), Random::mt); });
+    std::cout << "std::shuffle\t\t\t" << ms << " ms\n";
+
+    constexpr std::uint64_t seed{ 99 };
+    std::iota(values.begin(), values.end(), 0u);
+    ms = millisecondsFor([&] { Random::parallelShuffle<std::uint32_t>(values, seed, threads); });
+    std::cout << "Random::parallelShuffle\t\t" << ms << " ms\n";
+
+    std::vector<std::uint32_t> single(n);
+    std::iota(single.begin(), single.end(), 0u);
+    Random::parallelShuffle<std::uint32_t>(single, seed, 1);
+    const bool reproducible{ single == values };
+
+    std::sort(single.begin(), single.end());
+    bool permutation{ true };
+    for (std::size_t i{ 0 }; i < n; ++i)
+        permutation = permutation && single[i] == i;
+
+    std::cout << "\nparallel shuffle is a permutation: " << (permutation ? "yes" : "NO") << '\n';
+    std::cout << "same result with 1 and " << threads << " threads: " << (reproducible ? "yes" : "NO") << '\n';
+
+    return permutation && reproducible ? 0 : 1;
+}
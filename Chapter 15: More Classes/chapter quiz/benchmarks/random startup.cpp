@@ -0,0 +1,52 @@
+/*
+Random Startup Cost
+    random.h used to seed a global std::mt19937 (and the Random::fill engine) during static initialization,
+    so every program that included it paid for the std::random_device reads and the seeding before main() started.
+    The engines are now seeded the first time they're used instead.
+
+    This harness measures three things:
+        static init   time between the first global in this file being initialized and main() starting
+        first draw    how long the first Random::get takes (this is where lazy seeding now happens)
+        steady state  the average cost of later draws, to show the lazy version doesn't slow down the hot path
+
+    Build it both ways and compare:
+        g++ -std=c++20 -O2 "random startup.cpp" -o lazy
+        g++ -std=c++20 -O2 -DRANDOM_EAGER_INIT "random startup.cpp" -o eager
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <iostream> // included up here so its own startup work isn't counted
+
+// Defined before random.h is included, so it's initialized before anything random.h sets up at startup
+static const auto g_programStart{ std::chrono::steady_clock::now() };
+
+#include "../random.h"
+
+using Microseconds = std::chrono::duration<double, std::micro>;
+
+int main()
+{
+    const auto mainStart{ std::chrono::steady_clock::now() };
+
+    const auto firstDrawStart{ std::chrono::steady_clock::now() };
+    std::int64_t sum{ Random::get(1, 6) };
+    const auto firstDrawEnd{ std::chrono::steady_clock::now() };
+
+    constexpr std::int64_t draws{ 10'000'000 };
+    for (std::int64_t i{ 0 }; i < draws; ++i)
+        sum += Random::get(1, 6);
+    const auto steadyEnd{ std::chrono::steady_clock::now() };
+
+#ifdef RANDOM_EAGER_INIT
+    std::cout << "mode: eager (seeded before main)\n";
+#else
+    std::cout << "mode: lazy (seeded on first use)\n";
+#endif
+    std::cout << "static init:  " << Microseconds{ mainStart - g_programStart }.count() << " us\n";
+    std::cout << "first draw:   " << Microseconds{ firstDrawEnd - firstDrawStart }.count() << " us\n";
+    std::cout << "steady state: " << std::chrono::duration<double, std::nano>{ steadyEnd - firstDrawEnd }.count() / draws << " ns/draw\n";
+    std::cout << "(sum " << sum << ")\n";
+
+    return 0;
+}
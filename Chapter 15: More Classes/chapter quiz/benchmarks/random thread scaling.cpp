@@ -0,0 +1,70 @@
+/*
+Random::get Thread Scaling
+    With a single global std::mt19937, every thread calling Random::get reads and writes the same 2.5 KB of engine state.
+    That is a data race (undefined behavior), and even with a mutex around it, the cache lines holding the state bounce between cores on every call.
+
+    Defining RANDOM_PER_THREAD before including random.h makes Random::engine() thread_local, so each thread owns an independently seeded engine.
+    This benchmark runs the same number of draws per thread on 1, 2, 4, ... up to N threads and reports the total throughput.
+    With per-thread engines the total should grow roughly linearly with the number of cores.
+
+    Build: g++ -std=c++20 -O2 -pthread "random thread scaling.cpp"
+    Usage: ./a.out [draws per thread] [max threads]
+*/
+
+#define RANDOM_PER_THREAD
+#include "../random.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Draws `count` values and returns their sum so the compiler can't throw the work away
+std::int64_t drawMany(std::int64_t count)
+{
+    std::int64_t sum{ 0 };
+    for (std::int64_t i{ 0 }; i < count; ++i)
+        sum += Random::get(1, 6);
+    return sum;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::int64_t drawsPerThread{ argc > 1 ? std::stoll(argv[1]) : 20'000'000 };
+    const unsigned int maxThreads{ argc > 2 ? static_cast<unsigned int>(std::stoul(argv[2]))
+                                            : std::max(1u, std::thread::hardware_concurrency()) };
+
+    std::cout << "threads\tdraws/s (total)\tdraws/s (per thread)\n";
+
+    // 1, 2, 4, ... and always finish on exactly maxThreads
+    std::vector<unsigned int> threadCounts{};
+    for (unsigned int threads{ 1 }; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    for (unsigned int threads : threadCounts)
+    {
+        std::vector<std::int64_t> sums(threads);
+        std::vector<std::thread> workers{};
+        workers.reserve(threads);
+
+        const auto start{ std::chrono::steady_clock::now() };
+        for (unsigned int t{ 0 }; t < threads; ++t)
+            workers.emplace_back([&sums, t, drawsPerThread] { sums[t] = drawMany(drawsPerThread); });
+        for (auto& worker : workers)
+            worker.join();
+        const std::chrono::duration<double> elapsed{ std::chrono::steady_clock::now() - start };
+
+        const double total{ static_cast<double>(drawsPerThread) * threads / elapsed.count() };
+        std::cout << threads << '\t' << total << '\t' << total / threads << '\n';
+
+        // the sums are only kept so the draws can't be optimized out
+        if (std::all_of(sums.begin(), sums.end(), [](std::int64_t s) { return s == 0; }))
+            std::cout << "unexpected: every sum was zero\n";
+    }
+
+    return 0;
+}
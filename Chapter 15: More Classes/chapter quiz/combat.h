@@ -0,0 +1,192 @@
+#ifndef COMBAT_H
+#define COMBAT_H
+
+#include "monsterpool.h"
+
+#include <bit>
+#include <cstddef>
+#include <span>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Batched combat over a MonsterPool's hitpoints column.
+// Each round, every monster takes damage[i] damage. Rather than checking monsters one at a time with a branch,
+// the hitpoints are processed 8 at a time: subtract the damage, compare all 8 against zero at once, and turn the
+// comparison into an 8-bit mask (bit k set = monster k of the batch just died). Batches with an empty mask cost
+// nothing more, and counting deaths is a popcount of the mask.
+// Dead monsters are then compacted out of the pool in place, so the pool never reallocates.
+//
+// The batches use AVX2 when it's enabled (e.g. -mavx2 or -march=native), otherwise two SSE2 halves
+// (always available on x86-64), and plain loops anywhere else.
+namespace Combat
+{
+    constexpr std::size_t batchSize{ 8 };
+
+    namespace detail
+    {
+        // Subtracts damage from the 8 hitpoints at hp and returns the mask of the ones that went from alive to dead
+        inline unsigned int damageBatch(int* hp, const int* damage)
+        {
+#ifdef __AVX2__
+            const __m256i before{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hp)) };
+            const __m256i after{ _mm256_sub_epi32(before, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(damage))) };
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(hp), after);
+
+            const __m256i zero{ _mm256_setzero_si256() };
+            // alive before (before > 0) and not alive after (!(after > 0))
+            const __m256i died{ _mm256_andnot_si256(_mm256_cmpgt_epi32(after, zero), _mm256_cmpgt_epi32(before, zero)) };
+            return static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(died)));
+#elif defined(__SSE2__)
+            unsigned int mask{ 0 };
+            for (std::size_t half{ 0 }; half < batchSize; half += 4)
+            {
+                const __m128i before{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(hp + half)) };
+                const __m128i after{ _mm_sub_epi32(before, _mm_loadu_si128(reinterpret_cast<const __m128i*>(damage + half))) };
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(hp + half), after);
+
+                const __m128i zero{ _mm_setzero_si128() };
+                const __m128i died{ _mm_andnot_si128(_mm_cmpgt_epi32(after, zero), _mm_cmpgt_epi32(before, zero)) };
+                mask |= static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(died))) << half;
+            }
+            return mask;
+#else
+            unsigned int mask{ 0 };
+            for (std::size_t k{ 0 }; k < batchSize; ++k)
+            {
+                const int before{ hp[k] };
+                hp[k] = before - damage[k];
+                mask |= static_cast<unsigned int>(before > 0 && hp[k] <= 0) << k;
+            }
+            return mask;
+#endif
+        }
+
+        // Returns the mask of the monsters among the 8 hitpoints at hp that are dead
+        inline unsigned int deadBatch(const int* hp)
+        {
+#ifdef __AVX2__
+            const __m256i alive{ _mm256_cmpgt_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hp)), _mm256_setzero_si256()) };
+            return ~static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(alive))) & 0xFFu;
+#elif defined(__SSE2__)
+            const __m128i zero{ _mm_setzero_si128() };
+            const __m128i low{ _mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hp)), zero) };
+            const __m128i high{ _mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hp + 4)), zero) };
+            const auto alive{ static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(low)))
+                            | static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(high))) << 4 };
+            return ~alive & 0xFFu;
+#else
+            unsigned int mask{ 0 };
+            for (std::size_t k{ 0 }; k < batchSize; ++k)
+                mask |= static_cast<unsigned int>(hp[k] <= 0) << k;
+            return mask;
+#endif
+        }
+    }
+
+    // Subtracts damage[i] from hitpoints[i] for every monster and returns how many died (went from above 0 to 0 or below).
+    // damage must be at least as long as hitpoints.
+    inline std::size_t applyDamage(std::span<int> hitpoints, std::span<const int> damage)
+    {
+        const std::size_t n{ hitpoints.size() };
+        const std::size_t batched{ n - n % batchSize };
+        std::size_t deaths{ 0 };
+
+        for (std::size_t i{ 0 }; i < batched; i += batchSize)
+            deaths += static_cast<std::size_t>(std::popcount(detail::damageBatch(hitpoints.data() + i, damage.data() + i)));
+
+        for (std::size_t i{ batched }; i < n; ++i)
+        {
+            const int before{ hitpoints[i] };
+            hitpoints[i] -= damage[i];
+            deaths += (before > 0 && hitpoints[i] <= 0);
+        }
+
+        return deaths;
+    }
+
+    // Returns the index of the first dead monster, or hitpoints.size() if they're all alive
+    inline std::size_t firstDead(std::span<const int> hitpoints)
+    {
+        const std::size_t n{ hitpoints.size() };
+        const std::size_t batched{ n - n % batchSize };
+
+        for (std::size_t i{ 0 }; i < batched; i += batchSize)
+            if (const unsigned int mask{ detail::deadBatch(hitpoints.data() + i) })
+                return i + static_cast<std::size_t>(std::countr_zero(mask));
+
+        for (std::size_t i{ batched }; i < n; ++i)
+            if (hitpoints[i] <= 0)
+                return i;
+
+        return n;
+    }
+
+    // Removes the dead monsters from pool, keeping the rest in order, without reallocating. Returns how many were removed.
+    // The search for the first dead monster skips whole batches at a time, and the compaction starts there.
+    inline std::size_t removeDead(MonsterPool& pool)
+    {
+        const std::span<const int> hitpoints{ pool.hitpoints() };
+        const std::size_t first{ firstDead(hitpoints) };
+        if (first == hitpoints.size())
+            return 0;
+
+        return pool.eraseIf([hitpoints](std::size_t i) { return hitpoints[i] <= 0; }, first);
+    }
+
+    // Returns how many monsters are dead
+    inline std::size_t countDead(std::span<const int> hitpoints)
+    {
+        const std::size_t n{ hitpoints.size() };
+        const std::size_t batched{ n - n % batchSize };
+        std::size_t dead{ 0 };
+
+        for (std::size_t i{ 0 }; i < batched; i += batchSize)
+            dead += static_cast<std::size_t>(std::popcount(detail::deadBatch(hitpoints.data() + i)));
+        for (std::size_t i{ batched }; i < n; ++i)
+            dead += (hitpoints[i] <= 0);
+
+        return dead;
+    }
+
+    // Runs rounds of combat on a pool.
+    // Compacting the pool means moving every monster after the first dead one, which costs more than the damage pass
+    // itself, so a Battle leaves the dead where they are (more damage doesn't bring them back, and applyDamage doesn't
+    // count them again) until they make up 1/compactEvery of the pool, then removes them all in one pass.
+    class Battle
+    {
+    public:
+        static constexpr std::size_t compactEvery{ 8 };
+
+        explicit Battle(MonsterPool& pool) : m_pool{ pool }, m_dead{ countDead(pool.hitpoints()) }
+        {
+        }
+
+        // Damages monster i of the pool by damage[i] (dead ones included, so damage must cover the whole pool).
+        // Returns how many monsters died this round.
+        std::size_t round(std::span<const int> damage)
+        {
+            const std::size_t deaths{ applyDamage(m_pool.hitpoints(), damage) };
+            m_dead += deaths;
+            if (m_dead > 0 && m_dead * compactEvery >= m_pool.size())
+                removeDead();
+            return deaths;
+        }
+
+        // Removes the dead monsters now (e.g. before reading the pool)
+        void removeDead()
+        {
+            Combat::removeDead(m_pool);
+            m_dead = 0;
+        }
+
+        std::size_t alive() const { return m_pool.size() - m_dead; }
+
+    private:
+        MonsterPool& m_pool;
+        std::size_t m_dead{};
+    };
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef DICE_H
+#define DICE_H
+
+#include "parallel.h"
+#include "random.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Bulk dice rolling for Monte Carlo work.
+// The die6 loops in "mersenne twister.cpp" draw one roll at a time and print each one through std::cout.
+// Here a whole batch of "XdY+Z" rolls is written into a buffer (or straight into a histogram) across all cores,
+// and the text output is rendered into one big buffer and written in one go.
+//
+// Work is split into fixed-size chunks, and chunk i always draws from Random::seeded<Random::Xoshiro256x4>(seed, i),
+// so the rolls for a given seed are the same no matter how many threads run them.
+namespace Dice
+{
+    // XdY+Z: roll count dice with sides sides each, add them up, then add modifier
+    struct Expression
+    {
+        int count{ 1 };
+        int sides{ 6 };
+        int modifier{ 0 };
+
+        constexpr int min() const { return count + modifier; }
+        constexpr int max() const { return count * sides + modifier; }
+    };
+
+    // Parses "XdY", "XdY+Z", "XdY-Z" or "dY" (X defaults to 1). Returns std::nullopt if text isn't one of those,
+    // or if the smallest or largest total (and so any partial sum while rolling) wouldn't fit in an int.
+    inline std::optional<Expression> parse(std::string_view text)
+    {
+        const auto readInt = [&text](auto& value) {
+            const auto [end, error]{ std::from_chars(text.data(), text.data() + text.size(), value) };
+            if (error != std::errc{})
+                return false;
+            text.remove_prefix(static_cast<std::size_t>(end - text.data()));
+            return true;
+        };
+
+        Expression expression{};
+        if (!text.empty() && text.front() != 'd' && text.front() != 'D' && !readInt(expression.count))
+            return std::nullopt;
+
+        if (text.empty() || (text.front() != 'd' && text.front() != 'D'))
+            return std::nullopt;
+        text.remove_prefix(1);
+
+        if (!readInt(expression.sides))
+            return std::nullopt;
+
+        // read as a magnitude in 64 bits, so negating it can't overflow, and so "3d6--5" is an error rather than +5
+        std::int64_t modifier{ 0 };
+        if (!text.empty())
+        {
+            const bool negative{ text.front() == '-' };
+            if (text.front() != '+' && !negative)
+                return std::nullopt;
+            text.remove_prefix(1);
+
+            if (text.empty() || text.front() == '-' || text.front() == '+' || !readInt(modifier) || !text.empty())
+                return std::nullopt;
+            if (negative)
+                modifier = -modifier;
+        }
+
+        if (expression.count < 1 || expression.sides < 1)
+            return std::nullopt;
+
+        // checked in 64 bits, where count * sides + modifier can't overflow
+        const std::int64_t min{ std::int64_t{ expression.count } + modifier };
+        const std::int64_t max{ std::int64_t{ expression.count } * expression.sides + modifier };
+        if (modifier < std::numeric_limits<int>::min() || modifier > std::numeric_limits<int>::max()
+            || min < std::numeric_limits<int>::min() || max > std::numeric_limits<int>::max())
+            return std::nullopt;
+        expression.modifier = static_cast<int>(modifier);
+        return expression;
+    }
+
+    constexpr std::size_t rollsPerChunk{ 1 << 16 };
+
+    namespace detail
+    {
+        // Rolls count rolls for chunk number chunk of a batch, passing each total to sink
+        template <typename Sink>
+        void rollChunk(const Expression& expression, std::uint64_t seed, std::uint64_t chunk, std::size_t count, Sink sink)
+        {
+            Random::Xoshiro256x4 engine{ Random::seeded<Random::Xoshiro256x4>(seed, chunk) };
+            Random::detail::BulkWords words{ engine };
+            const auto sides{ static_cast<std::uint32_t>(expression.sides) };
+
+            for (std::size_t i{ 0 }; i < count; ++i)
+            {
+                // bounded32 gives faces numbered from 0, so start at 1 per die (plus the modifier)
+                int total{ expression.count + expression.modifier };
+                for (int die{ 0 }; die < expression.count; ++die)
+                    total += static_cast<int>(Random::detail::bounded32(words, sides));
+                sink(i, total);
+            }
+        }
+    }
+
+    // Fills out with rolls of expression
+    // Sample call: Dice::roll(*Dice::parse("3d6"), std::span{ rolls }, seed);
+    inline void roll(const Expression& expression, std::span<int> out, std::uint64_t seed,
+                     unsigned int threads = Parallel::defaultThreads())
+    {
+        Parallel::forEachChunkOf(out.size(), rollsPerChunk, threads, [&](std::uint64_t chunk, std::uint64_t first, std::size_t count, unsigned int) {
+            int* rolls{ out.data() + first };
+            detail::rollChunk(expression, seed, chunk, count, [rolls](std::size_t i, int total) { rolls[i] = total; });
+        });
+    }
+
+    // The most counters histogram() uses while rolling, over all threads and copies (64 MB), and so also the most
+    // possible totals it will count
+    constexpr std::size_t maxHistogramCounters{ 1 << 23 };
+
+    // Rolls expression rolls times and returns how often each total came up.
+    // Element i of the result counts the rolls that totalled expression.min() + i. The rolls themselves are never stored.
+    // Returns an empty vector if expression has more than maxHistogramCounters possible totals (e.g. 1000d100000).
+    inline std::vector<std::uint64_t> histogram(const Expression& expression, std::uint64_t rolls, std::uint64_t seed,
+                                                unsigned int threads = Parallel::defaultThreads())
+    {
+        threads = std::max(1u, threads);
+        const auto totals{ static_cast<std::size_t>(std::int64_t{ expression.max() } - expression.min() + 1) };
+        if (totals > maxHistogramCounters)
+            return {};
+
+        // Each thread gets its own histogram, so the threads never write to the same counters.
+        // Within a thread, consecutive rolls go to four interleaved copies of the histogram, because rolls
+        // that keep landing on the same popular total would otherwise wait on each other's increments.
+        // Wide histograms rarely hit the same total twice in a row, so when the copies wouldn't fit in
+        // maxHistogramCounters each thread keeps one, and if even that doesn't fit fewer threads run.
+        // The chunks decide the rolls, so the result is the same either way.
+        const std::size_t copies{ totals * 4 * threads <= maxHistogramCounters ? 4u : 1u };
+        threads = static_cast<unsigned int>(std::min<std::size_t>(threads, maxHistogramCounters / (totals * copies)));
+        std::vector<std::vector<std::uint64_t>> perThread(threads, std::vector<std::uint64_t>(totals * copies));
+
+        Parallel::forEachChunkOf(rolls, rollsPerChunk, threads, [&](std::uint64_t chunk, std::uint64_t, std::size_t count, unsigned int thread) {
+            std::uint64_t* counts{ perThread[thread].data() };
+            const int min{ expression.min() };
+            const std::size_t copyMask{ copies - 1 };
+            detail::rollChunk(expression, seed, chunk, count, [counts, min, totals, copyMask](std::size_t i, int total) {
+                ++counts[(i & copyMask) * totals + static_cast<std::size_t>(total - min)];
+            });
+        });
+
+        std::vector<std::uint64_t> result(totals);
+        for (const auto& counts : perThread)
+            for (std::size_t i{ 0 }; i < counts.size(); ++i)
+                result[i % totals] += counts[i];
+        return result;
+    }
+
+    // Writes rolls to out in the same layout as "mersenne twister.cpp" (tab separated, 10 per row),
+    // but renders them into a reusable buffer with std::to_chars and writes it out in large blocks
+    inline void print(std::span<const int> rolls, std::ostream& out)
+    {
+        std::vector<char> buffer(1 << 16);
+        std::size_t used{ 0 };
+
+        for (std::size_t i{ 0 }; i < rolls.size(); ++i)
+        {
+            if (buffer.size() - used < 16) // enough room for any int and a separator
+            {
+                out.write(buffer.data(), static_cast<std::streamsize>(used));
+                used = 0;
+            }
+
+            const auto [end, error]{ std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), rolls[i]) };
+            used = static_cast<std::size_t>(end - buffer.data());
+            buffer[used++] = ((i + 1) % 10 == 0) ? '\n' : '\t';
+        }
+
+        out.write(buffer.data(), static_cast<std::streamsize>(used));
+    }
+}
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef MONSTER_H
+#define MONSTER_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "parallel.h"
+#include "random.h"
+#include "stringtable.h"
+#include "../../Chapter 13: Enums and Structs/enumtable.h"
+
+// Monster and MonsterGenerator from the chapter quiz, moved into a header (see "classes and header files.cpp")
+// so the tools and benchmarks in this directory can share them.
+// Names and roars are interned in Monster::strings(), and a Monster only holds their ids, so copying
+// or generating monsters never allocates (the quiz version held two std::strings, and any name or roar
+// longer than the small string buffer cost a heap allocation per monster).
+class Monster {
+    public:
+        enum Type {
+            dragon,
+            goblin,
+            ogre,
+            orc,
+            skeleton,
+            troll,
+            vampire,
+            zombie,
+
+            maxMonsterTypes,
+        };
+    private:
+        Type m_type{};
+        StringTable::Id m_name{};
+        StringTable::Id m_roar{};
+        int m_hitpoints{};
+
+    public:
+        // names in enumerator order (see enumtable.h)
+        static constexpr auto typeNames{ makeEnumNames<Type>("dragon", "goblin", "ogre", "orc", "skeleton", "troll", "vampire", "zombie") };
+        static_assert(typeNames.size() == maxMonsterTypes);
+
+        static constexpr std::string_view getTypeString(Type type) {
+            return typeNames.name(type);
+        }
+
+        constexpr std::string_view getTypeString() const { return getTypeString(m_type); }
+
+        // The table every monster's name and roar lives in
+        static StringTable& strings() {
+            static StringTable table{};
+            static const StringTable::Id unknown{ table.intern("???") }; // id 0, the name and roar of a default-constructed Monster
+            (void)unknown;
+            return table;
+        }
+
+        Monster(Type type, std::string_view name, std::string_view roar, int hitpoints): m_type {type}, m_name {strings().intern(name)}, m_roar {strings().intern(roar)}, m_hitpoints {hitpoints} {}
+        // For names and roars that are already interned (no lookup, no allocation)
+        Monster(Type type, StringTable::Id name, StringTable::Id roar, int hitpoints): m_type {type}, m_name {name}, m_roar {roar}, m_hitpoints {hitpoints} {}
+        // An empty slot, so buffers of monsters can be allocated up front and filled in later
+        Monster() = default;
+
+        // Two monsters are equal if every field is (interned strings are equal exactly when their ids are)
+        bool operator==(const Monster&) const = default;
+
+        Type getType() const { return m_type; }
+        std::string_view getName() const { return strings().view(m_name); }
+        std::string_view getRoar() const { return strings().view(m_roar); }
+        StringTable::Id getNameId() const { return m_name; }
+        StringTable::Id getRoarId() const { return m_roar; }
+        int getHitpoints() const { return m_hitpoints; }
+        void print() const {
+            std::cout << getName() << " the " << getTypeString();
+            if (m_hitpoints <= 0) {
+                std::cout << " is dead.\n";
+            } else {
+                std::cout << " has " << m_hitpoints << " hitpoints and says " << getRoar() << ".\n";
+            }
+        }
+};
+
+namespace MonsterGenerator {
+    constexpr auto names{ makeEnumNames<int>("Bones", "Crusty", "Blarg", "Goofy", "Hungry", "Destroyer of Worlds") };
+    constexpr auto roars{ makeEnumNames<int>("*rattle*", "*tonk*", "*rustle*", "*screech*", "*arf arf*", "you will soon crave the sweet release of death") };
+
+    constexpr int nameCount{ static_cast<int>(names.size()) }; // getName and getRoar know names and roars numbered 0 to 5
+    constexpr int roarCount{ static_cast<int>(roars.size()) };
+
+    constexpr std::string_view getName (int nameNum) {
+        return names.name(nameNum, "");
+    }
+
+    constexpr std::string_view getRoar (int roarNum) {
+        return roars.name(roarNum, "");
+    }
+
+    // The interned ids of getName(0..5) and getRoar(0..5), looked up once on first use
+    inline StringTable::Id nameId(int nameNum) {
+        static const auto ids{ [] {
+            std::array<StringTable::Id, nameCount> result{};
+            for (int i{ 0 }; i < nameCount; ++i)
+                result[static_cast<std::size_t>(i)] = Monster::strings().intern(getName(i));
+            return result;
+        }() };
+        return ids[static_cast<std::size_t>(nameNum)];
+    }
+
+    inline StringTable::Id roarId(int roarNum) {
+        static const auto ids{ [] {
+            std::array<StringTable::Id, roarCount> result{};
+            for (int i{ 0 }; i < roarCount; ++i)
+                result[static_cast<std::size_t>(i)] = Monster::strings().intern(getRoar(i));
+            return result;
+        }() };
+        return ids[static_cast<std::size_t>(roarNum)];
+    }
+
+    inline Monster generate() {
+        // the ranges are all constants, so use the Random::get<min, max>() overload
+        return Monster{ static_cast<Monster::Type>(Random::get<0, Monster::maxMonsterTypes - 1>()), 
+                nameId(Random::get<0, nameCount - 1>()), 
+                roarId(Random::get<0, roarCount - 1>()),
+                Random::get<1, 100>()};
+    }
+
+    // Populations are cut into chunks of this many monsters, and chunk i draws from Random stream i
+    constexpr std::size_t monstersPerChunk{ 1 << 16 };
+
+    namespace detail {
+        // Draws count monsters for chunk number chunk, passing sink(i, type, nameNum, roarNum, hitpoints) for each
+        template <typename Sink>
+        void generateChunk(std::uint64_t seed, std::uint64_t chunk, std::size_t count, Sink sink) {
+            Random::Xoshiro256x4 engine{ Random::seeded<Random::Xoshiro256x4>(seed, chunk) };
+            Random::detail::BulkWords words{ engine };
+
+            for (std::size_t i{ 0 }; i < count; ++i) {
+                const auto type{ static_cast<Monster::Type>(Random::detail::bounded32<Monster::maxMonsterTypes>(words)) };
+                const auto nameNum{ static_cast<int>(Random::detail::bounded32<nameCount>(words)) };
+                const auto roarNum{ static_cast<int>(Random::detail::bounded32<roarCount>(words)) };
+                const auto hitpoints{ static_cast<int>(Random::detail::bounded32<100>(words)) + 1 };
+                sink(i, type, nameNum, roarNum, hitpoints);
+            }
+        }
+    }
+
+    // Fills out with random monsters using every core.
+    // The result only depends on seed (not on threads), and nothing is allocated apart from the worker threads.
+    // Sample call: MonsterGenerator::generatePopulation(std::span{ monsters }, seed);
+    inline void generatePopulation(std::span<Monster> out, std::uint64_t seed, unsigned int threads = Parallel::defaultThreads()) {
+        std::array<StringTable::Id, nameCount> names{};
+        for (int i{ 0 }; i < nameCount; ++i)
+            names[static_cast<std::size_t>(i)] = nameId(i);
+        std::array<StringTable::Id, roarCount> roars{};
+        for (int i{ 0 }; i < roarCount; ++i)
+            roars[static_cast<std::size_t>(i)] = roarId(i);
+
+        Parallel::forEachChunkOf(out.size(), monstersPerChunk, threads, [&](std::uint64_t chunk, std::uint64_t first, std::size_t count, unsigned int) {
+            Monster* monsters{ out.data() + first };
+            detail::generateChunk(seed, chunk, count,
+                [monsters, &names, &roars](std::size_t i, Monster::Type type, int nameNum, int roarNum, int hitpoints) {
+                    monsters[i] = Monster{ type, names[static_cast<std::size_t>(nameNum)], roars[static_cast<std::size_t>(roarNum)], hitpoints };
+                });
+        });
+    }
+
+    // Returns count random monsters (see above)
+    inline std::vector<Monster> generatePopulation(std::size_t count, std::uint64_t seed, unsigned int threads = Parallel::defaultThreads()) {
+        std::vector<Monster> monsters(count);
+        generatePopulation(std::span{ monsters }, seed, threads);
+        return monsters;
+    }
+}
+
+#endif
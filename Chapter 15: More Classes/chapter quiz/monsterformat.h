@@ -0,0 +1,105 @@
+#ifndef MONSTERFORMAT_H
+#define MONSTERFORMAT_H
+
+#include "monster.h"
+#include "monsterpool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Bulk text output for monsters.
+// Monster::print() makes five or six separate std::cout << calls per monster, each going through the stream's
+// sentry and locale machinery. MonsterFormatter renders a whole range of monsters into one reusable char buffer
+// (numbers with std::to_chars) and writes the result with a single ostream::write.
+// The text is byte for byte what print() would have written for each monster in turn.
+// Sample call:
+//     MonsterFormatter formatter{};
+//     formatter.write(std::span{ monsters }, std::cout);
+class MonsterFormatter
+{
+public:
+    // Appends the text for one monster to the buffer
+    void append(Monster::Type type, std::string_view name, std::string_view roar, int hitpoints)
+    {
+        reserve(name.size() + roar.size() + 64); // 64 covers the fixed text, the type and the number
+        put(name);
+        put(" the ");
+        put(Monster::getTypeString(type));
+        if (hitpoints <= 0)
+        {
+            put(" is dead.\n");
+            return;
+        }
+
+        put(" has ");
+        const auto [end, error]{ std::to_chars(m_buffer.data() + m_used, m_buffer.data() + m_buffer.size(), hitpoints) };
+        m_used = static_cast<std::size_t>(end - m_buffer.data());
+        put(" hitpoints and says ");
+        put(roar);
+        put(".\n");
+    }
+
+    void append(const Monster& monster)
+    {
+        append(monster.getType(), monster.getName(), monster.getRoar(), monster.getHitpoints());
+    }
+
+    void append(std::span<const Monster> monsters)
+    {
+        for (const Monster& monster : monsters)
+            append(monster);
+    }
+
+    void append(const MonsterPool& pool)
+    {
+        pool.forEach([this](Monster::Type type, MonsterPool::Id name, MonsterPool::Id roar, int hitpoints) {
+            append(type, MonsterGenerator::getName(name), MonsterGenerator::getRoar(roar), hitpoints);
+        });
+    }
+
+    // The text rendered so far
+    std::string_view text() const { return { m_buffer.data(), m_used }; }
+
+    // Empties the buffer, keeping its memory for next time
+    void clear() { m_used = 0; }
+
+    // Writes the buffer to out in one go and empties it
+    void flush(std::ostream& out)
+    {
+        out.write(m_buffer.data(), static_cast<std::streamsize>(m_used));
+        clear();
+    }
+
+    // Renders monsters and writes them to out with one write
+    template <typename Monsters>
+    void write(const Monsters& monsters, std::ostream& out)
+    {
+        append(monsters);
+        flush(out);
+    }
+
+private:
+    std::vector<char> m_buffer{}; // m_buffer.size() is the capacity, m_used how much of it holds text
+    std::size_t m_used{ 0 };
+
+    // Makes sure at least extra more chars fit, so put() never has to check
+    void reserve(std::size_t extra)
+    {
+        if (m_buffer.size() - m_used < extra)
+            m_buffer.resize(std::max(m_buffer.size() * 2, m_used + extra));
+    }
+
+    void put(std::string_view text)
+    {
+        std::memcpy(m_buffer.data() + m_used, text.data(), text.size());
+        m_used += text.size();
+    }
+};
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef MONSTERPOOL_H
+#define MONSTERPOOL_H
+
+#include "monster.h"
+#include "parallel.h"
+#include "random.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// A structure-of-arrays container for very large numbers of monsters.
+// A Monster object is 16 bytes (a 4-byte Type, two string ids and the hitpoints), so a pass over the
+// hitpoints of a std::vector<Monster> still drags the other 12 bytes of every monster through the cache.
+// MonsterPool instead keeps each field in its own contiguous column, with names and roars stored as the small
+// numbers MonsterGenerator::getName and getRoar already use:
+//     types      1 byte per monster
+//     names      1 byte per monster
+//     roars      1 byte per monster
+//     hitpoints  4 bytes per monster
+// so a pass over hitpoints reads exactly 4 bytes per monster, and the compiler can vectorize it.
+class MonsterPool
+{
+public:
+    using Id = std::uint8_t;
+
+    std::size_t size() const { return m_hitpoints.size(); }
+    bool empty() const { return m_hitpoints.empty(); }
+
+    void reserve(std::size_t count)
+    {
+        m_types.reserve(count);
+        m_names.reserve(count);
+        m_roars.reserve(count);
+        m_hitpoints.reserve(count);
+    }
+
+    void clear()
+    {
+        m_types.clear();
+        m_names.clear();
+        m_roars.clear();
+        m_hitpoints.clear();
+    }
+
+    void add(Monster::Type type, Id name, Id roar, int hitpoints)
+    {
+        m_types.push_back(static_cast<Id>(type));
+        m_names.push_back(name);
+        m_roars.push_back(roar);
+        m_hitpoints.push_back(hitpoints);
+    }
+
+    // Adds count random monsters (with the same ranges as MonsterGenerator::generate), one column at a time with Random::fill
+    void generate(std::size_t count)
+    {
+        const std::size_t first{ size() };
+        resize(first + count);
+
+        Random::fill(std::span{ m_types }.subspan(first), Id{ 0 }, static_cast<Id>(Monster::maxMonsterTypes - 1));
+        Random::fill(std::span{ m_names }.subspan(first), Id{ 0 }, static_cast<Id>(MonsterGenerator::nameCount - 1));
+        Random::fill(std::span{ m_roars }.subspan(first), Id{ 0 }, static_cast<Id>(MonsterGenerator::roarCount - 1));
+        Random::fill(std::span{ m_hitpoints }.subspan(first), 1, 100);
+    }
+
+    // Adds count random monsters using every core. The result only depends on seed (not on threads),
+    // and matches MonsterGenerator::generatePopulation for the same seed monster for monster.
+    void generate(std::size_t count, std::uint64_t seed, unsigned int threads = Parallel::defaultThreads())
+    {
+        const std::size_t first{ size() };
+        resize(first + count);
+
+        Parallel::forEachChunkOf(count, MonsterGenerator::monstersPerChunk, threads,
+                                 [&](std::uint64_t chunk, std::uint64_t chunkFirst, std::size_t chunkCount, unsigned int) {
+            const std::size_t offset{ first + static_cast<std::size_t>(chunkFirst) };
+            MonsterGenerator::detail::generateChunk(seed, chunk, chunkCount,
+                [this, offset](std::size_t i, Monster::Type type, int nameNum, int roarNum, int hitpoints) {
+                    m_types[offset + i] = static_cast<Id>(type);
+                    m_names[offset + i] = static_cast<Id>(nameNum);
+                    m_roars[offset + i] = static_cast<Id>(roarNum);
+                    m_hitpoints[offset + i] = hitpoints;
+                });
+        });
+    }
+
+    // The columns, for loops that only need one or two fields
+    std::span<const Id> types() const { return m_types; }
+    std::span<const Id> names() const { return m_names; }
+    std::span<const Id> roars() const { return m_roars; }
+    std::span<const int> hitpoints() const { return m_hitpoints; }
+    std::span<int> hitpoints() { return m_hitpoints; }
+
+    Monster::Type type(std::size_t index) const { return static_cast<Monster::Type>(m_types[index]); }
+
+    // Builds a regular Monster object for monster number index (e.g. to print it)
+    Monster toMonster(std::size_t index) const
+    {
+        return Monster{ type(index), MonsterGenerator::nameId(m_names[index]),
+                        MonsterGenerator::roarId(m_roars[index]), m_hitpoints[index] };
+    }
+
+    // Calls fn(type, name, roar, hitpoints) for every monster, in order
+    template <typename Function>
+    void forEach(Function fn) const
+    {
+        for (std::size_t i{ 0 }; i < size(); ++i)
+            fn(type(i), m_names[i], m_roars[i], m_hitpoints[i]);
+    }
+
+    // Removes monster number index in O(1) by moving the last monster into its place (so the order changes)
+    void erase(std::size_t index)
+    {
+        const std::size_t last{ size() - 1 };
+        m_types[index] = m_types[last];
+        m_names[index] = m_names[last];
+        m_roars[index] = m_roars[last];
+        m_hitpoints[index] = m_hitpoints[last];
+        resize(last);
+    }
+
+    // Removes every monster for which shouldErase(index) returns true, keeping the rest in order.
+    // Runs in one pass over the columns and never reallocates. Returns how many were removed.
+    // If the caller already knows nothing before index first needs erasing, the pass can start there.
+    template <typename Predicate>
+    std::size_t eraseIf(Predicate shouldErase, std::size_t first = 0)
+    {
+        std::size_t kept{ first };
+        for (std::size_t i{ first }; i < size(); ++i)
+        {
+            // copy unconditionally and only advance past the monsters we keep,
+            // so there's no branch to mispredict when erased monsters are scattered at random
+            const bool erase{ shouldErase(i) };
+            m_types[kept] = m_types[i];
+            m_names[kept] = m_names[i];
+            m_roars[kept] = m_roars[i];
+            m_hitpoints[kept] = m_hitpoints[i];
+            kept += !erase;
+        }
+
+        const std::size_t removed{ size() - kept };
+        resize(kept);
+        return removed;
+    }
+
+    // Removes every monster with no hitpoints left
+    std::size_t eraseDead()
+    {
+        return eraseIf([this](std::size_t i) { return m_hitpoints[i] <= 0; });
+    }
+
+    // Bytes of column storage in use (capacity, not size)
+    std::size_t memoryUsage() const
+    {
+        return m_types.capacity() * sizeof(Id) + m_names.capacity() * sizeof(Id)
+             + m_roars.capacity() * sizeof(Id) + m_hitpoints.capacity() * sizeof(int);
+    }
+
+private:
+    std::vector<Id> m_types{};
+    std::vector<Id> m_names{};
+    std::vector<Id> m_roars{};
+    std::vector<int> m_hitpoints{};
+
+    void resize(std::size_t count)
+    {
+        m_types.resize(count);
+        m_names.resize(count);
+        m_roars.resize(count);
+        m_hitpoints.resize(count);
+    }
+};
+
+#endif
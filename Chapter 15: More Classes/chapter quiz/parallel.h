@@ -0,0 +1,61 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// A tiny helper for the bulk generators in this directory (dice.h, sampling.h, ...).
+// Work is cut into numbered chunks up front and threads claim the next unclaimed chunk until none are left.
+// As long as each chunk's result only depends on its number (e.g. chunk i draws from Random stream i),
+// the output is the same no matter how many threads run it, or which thread gets which chunk.
+namespace Parallel
+{
+    inline unsigned int defaultThreads()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Calls work(chunk, thread) for every chunk in [0, chunks) on threads threads (the calling thread is thread 0)
+    template <typename Work>
+    void forEachChunk(std::uint64_t chunks, unsigned int threads, Work work)
+    {
+        threads = static_cast<unsigned int>(std::clamp<std::uint64_t>(chunks, 1, std::max(1u, threads)));
+        std::atomic<std::uint64_t> next{ 0 };
+
+        const auto worker = [&](unsigned int thread) {
+            for (std::uint64_t chunk{ next++ }; chunk < chunks; chunk = next++)
+                work(chunk, thread);
+        };
+
+        std::vector<std::thread> helpers{};
+        for (unsigned int t{ 1 }; t < threads; ++t)
+            helpers.emplace_back(worker, t);
+        worker(0);
+        for (auto& helper : helpers)
+            helper.join();
+    }
+
+    // How many of items fall in chunk number chunk, when they're cut into chunks of chunkSize (only the last can be short)
+    constexpr std::size_t chunkLength(std::uint64_t items, std::size_t chunkSize, std::uint64_t chunk)
+    {
+        return static_cast<std::size_t>(std::min<std::uint64_t>(chunkSize, items - chunk * chunkSize));
+    }
+
+    // Cuts items [0, items) into chunks of chunkSize and calls work(chunk, first, count, thread) for each,
+    // where the chunk covers items [first, first + count). Sample call:
+    //     Parallel::forEachChunkOf(out.size(), itemsPerChunk, threads, [&](std::uint64_t chunk, std::uint64_t first, std::size_t count, unsigned int) { ... });
+    template <typename Work>
+    void forEachChunkOf(std::uint64_t items, std::size_t chunkSize, unsigned int threads, Work work)
+    {
+        const std::uint64_t chunks{ (items + chunkSize - 1) / chunkSize };
+        forEachChunk(chunks, threads, [&](std::uint64_t chunk, unsigned int thread) {
+            work(chunk, chunk * chunkSize, chunkLength(items, chunkSize, chunk), thread);
+        });
+    }
+}
+
+#endif
@@ -1,39 +1,525 @@
 #ifndef RANDOM_MT_H
 #define RANDOM_MT_H
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <random>
+#include <span>
+#include <type_traits>
 
-// This header-only Random namespace implements a self-seeding Mersenne Twister.
-// Requires C++17 or newer.
+// This header-only Random namespace implements a self-seeding random number generator (a Mersenne Twister by default).
+// Requires C++20 or newer (Random::fill takes a std::span).
 // It can be #included into as many code files as needed (The inline keyword avoids ODR violations)
 // Freely redistributable, courtesy of learncpp.com (https://www.learncpp.com/cpp-tutorial/global-random-numbers-random-h/)
-namespace Random
+//
+// Configuration
+// RANDOM_ENGINE, RANDOM_PER_THREAD and RANDOM_EAGER_INIT (described below) change the bodies of the inline functions
+// and variables in this header. Every code file of a program must include it with the same ones defined:
+// define them project-wide (e.g. -DRANDOM_PER_THREAD) rather than above one #include.
+// If two files disagree anyway, that would be an ODR violation no compiler or linker reports, with one of the two
+// definitions silently used everywhere. So everything here lives in an inline namespace named after the settings
+// (e.g. Random::cfg_shared_lazy_mt19937), and files built with different settings get separate engines instead.
+// Only whether RANDOM_ENGINE is set shows up in the name, not which engine it is, so keep it in one place.
+#ifdef RANDOM_PER_THREAD
+#define RANDOM_CONFIG_THREADS per_thread
+#else
+#define RANDOM_CONFIG_THREADS shared
+#endif
+#ifdef RANDOM_EAGER_INIT
+#define RANDOM_CONFIG_INIT eager
+#else
+#define RANDOM_CONFIG_INIT lazy
+#endif
+#ifdef RANDOM_ENGINE
+#define RANDOM_CONFIG_ENGINE custom
+#else
+#define RANDOM_CONFIG_ENGINE mt19937
+#endif
+#define RANDOM_CONFIG_JOIN(threads, init, engine) cfg_##threads##_##init##_##engine
+#define RANDOM_CONFIG_NAME(threads, init, engine) RANDOM_CONFIG_JOIN(threads, init, engine)
+// The inline namespace for this file's settings (headers that add to Random, like sampling.h, open it too)
+#define RANDOM_CONFIG_NAMESPACE RANDOM_CONFIG_NAME(RANDOM_CONFIG_THREADS, RANDOM_CONFIG_INIT, RANDOM_CONFIG_ENGINE)
+
+namespace Random::inline RANDOM_CONFIG_NAMESPACE
 {
-	// Returns a seeded Mersenne Twister
-	// Note: we'd prefer to return a std::seed_seq (to initialize a std::mt19937), but std::seed can't be copied, so it can't be returned by value.
-	// Instead, we'll create a std::mt19937, seed it, and then return the std::mt19937 (which can be copied).
-	inline std::mt19937 generate()
+	// Engines
+	// std::mt19937 is a good default, but its state is 2.5 KB (5 KB in libstdc++), which crowds everything else out of the L1 cache.
+	// The engines below all meet the requirements of a UniformRandomBitGenerator, so they work with the standard
+	// distributions as well as with Random::get. Pick one at compile time by defining RANDOM_ENGINE before
+	// including this header, e.g.
+	//     #define RANDOM_ENGINE Random::Pcg32
+	//     #include "random.h"
+	//
+	// engine                  state    output    notes
+	// std::mt19937         2.5-5 KB    32 bits   the standard library default
+	// Random::Pcg32            16 B    32 bits   small and fast, good statistical quality
+	// Random::Xoshiro256ss     32 B    64 bits   fastest general purpose 64-bit engine here
+	// Random::SplitMix64        8 B    64 bits   tiny, mostly used to seed other engines
+	// Random::Lcg32             8 B    32 bits   the same kind of LCG with 64-bit state; fine for games, not for statistics
+	// Random::Lcg16             4 B    15 bits   the LCG from "intro to rng.cpp", cheap but poor quality (illustration only)
+	// benchmarks/random engines.cpp prints ns/value for each of these on your machine.
+
+	namespace detail
+	{
+		// Pulls count 64-bit words out of a std::seed_seq (which only hands out 32-bit values)
+		template <std::size_t count>
+		std::array<std::uint64_t, count> seedWords(std::seed_seq& ss)
+		{
+			std::array<std::uint32_t, count * 2> halves{};
+			ss.generate(halves.begin(), halves.end());
+
+			std::array<std::uint64_t, count> words{};
+			for (std::size_t i{ 0 }; i < count; ++i)
+				words[i] = (static_cast<std::uint64_t>(halves[i * 2]) << 32) | halves[i * 2 + 1];
+			return words;
+		}
+
+		constexpr std::uint64_t rotl(std::uint64_t x, int k)
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+	}
+
+	// Linear congruential generators: state = multiplier * state + increment, with overflow doing the modulo.
+	// Output is bits bits of the new state, starting at bit shift.
+	// Everything but the std::seed_seq constructor is constexpr, so these can run at compile time (see Random::table below).
+	template <typename UInt, UInt multiplier, UInt increment, int shift, int bits>
+	class LinearCongruential
+	{
+	public:
+		using result_type = std::uint32_t;
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return static_cast<result_type>((std::uint64_t{ 1 } << bits) - 1); }
+
+		constexpr explicit LinearCongruential(UInt seed = 0) : m_state{ seed } {}
+		explicit LinearCongruential(std::seed_seq& ss) : m_state{ static_cast<UInt>(detail::seedWords<1>(ss)[0]) } {}
+
+		constexpr result_type operator()()
+		{
+			m_state = static_cast<UInt>(multiplier * m_state + increment);
+			return static_cast<result_type>((m_state >> shift) & max());
+		}
+
+	private:
+		UInt m_state{};
+	};
+
+	// The generator from "intro to rng.cpp" (its output is the low 15 bits of the state, hence the poor quality)
+	using Lcg16 = LinearCongruential<std::uint32_t, 8253729, 2396403, 0, 15>;
+
+	// The same recurrence with Knuth's 64-bit MMIX constants, keeping the (much better) high 32 bits
+	using Lcg32 = LinearCongruential<std::uint64_t, 6364136223846793005, 1442695040888963407, 32, 32>;
+
+	// SplitMix64 (https://prng.di.unimi.it/splitmix64.c)
+	class SplitMix64
+	{
+	public:
+		using result_type = std::uint64_t;
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFFFFFFFFFF; }
+
+		constexpr explicit SplitMix64(std::uint64_t seed = 0) : m_state{ seed } {}
+		explicit SplitMix64(std::seed_seq& ss) : m_state{ detail::seedWords<1>(ss)[0] } {}
+
+		constexpr result_type operator()()
+		{
+			std::uint64_t z{ m_state += 0x9E3779B97F4A7C15 };
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+			return z ^ (z >> 31);
+		}
+
+	private:
+		std::uint64_t m_state{};
+	};
+
+	// PCG32, the XSH-RR variant (https://www.pcg-random.org/)
+	class Pcg32
+	{
+	public:
+		using result_type = std::uint32_t;
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFF; }
+
+		constexpr explicit Pcg32(std::uint64_t seed = 0x853C49E6748FEA9B, std::uint64_t stream = 0xDA3E39CB94B95BDB)
+		{
+			seedWith(seed, stream);
+		}
+
+		explicit Pcg32(std::seed_seq& ss)
+		{
+			const auto words{ detail::seedWords<2>(ss) };
+			seedWith(words[0], words[1]);
+		}
+
+		constexpr result_type operator()()
+		{
+			const std::uint64_t old{ m_state };
+			m_state = old * 6364136223846793005 + m_increment;
+			const auto xorshifted{ static_cast<std::uint32_t>(((old >> 18) ^ old) >> 27) };
+			const auto rot{ static_cast<int>(old >> 59) };
+			return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+		}
+
+	private:
+		std::uint64_t m_state{};
+		std::uint64_t m_increment{}; // must be odd
+
+		constexpr void seedWith(std::uint64_t seed, std::uint64_t stream)
+		{
+			m_state = 0;
+			m_increment = (stream << 1) | 1;
+			(*this)();
+			m_state += seed;
+			(*this)();
+		}
+	};
+
+	// xoshiro256** (https://prng.di.unimi.it/xoshiro256starstar.c)
+	class Xoshiro256ss
+	{
+	public:
+		using result_type = std::uint64_t;
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFFFFFFFFFF; }
+
+		// Seeds all four words from SplitMix64, as the authors recommend
+		constexpr explicit Xoshiro256ss(std::uint64_t seed = 0)
+		{
+			SplitMix64 sm{ seed };
+			for (std::uint64_t& word : m_s)
+				word = sm();
+		}
+
+		explicit Xoshiro256ss(std::seed_seq& ss) : m_s{ detail::seedWords<4>(ss) }
+		{
+			if ((m_s[0] | m_s[1] | m_s[2] | m_s[3]) == 0) // the all-zero state never leaves zero
+				m_s[0] = 0x9E3779B97F4A7C15;
+		}
+
+		constexpr result_type operator()()
+		{
+			const std::uint64_t result{ detail::rotl(m_s[1] * 5, 7) * 9 };
+			const std::uint64_t t{ m_s[1] << 17 };
+
+			m_s[2] ^= m_s[0];
+			m_s[3] ^= m_s[1];
+			m_s[1] ^= m_s[2];
+			m_s[0] ^= m_s[3];
+			m_s[2] ^= t;
+			m_s[3] = detail::rotl(m_s[3], 45);
+
+			return result;
+		}
+
+		// Advances the state by 2^128 draws, as if operator() had been called that many times.
+		// Seeding once and jumping i times gives worker i a stream that can't overlap any other worker's.
+		constexpr void jump()
+		{
+			constexpr std::array<std::uint64_t, 4> jumpPolynomial{
+				0x180EC6D33CFD0ABA, 0xD5A61266F0C9392C, 0xA9582618E03FC9AA, 0x39ABDC4529B1661C };
+
+			std::array<std::uint64_t, 4> s{};
+			for (std::uint64_t word : jumpPolynomial)
+				for (int bit{ 0 }; bit < 64; ++bit)
+				{
+					if (word & (std::uint64_t{ 1 } << bit))
+						for (std::size_t i{ 0 }; i < s.size(); ++i)
+							s[i] ^= m_s[i];
+					(*this)();
+				}
+
+			m_s = s;
+		}
+
+	private:
+		std::array<std::uint64_t, 4> m_s{};
+	};
+
+#ifdef RANDOM_ENGINE
+	using Engine = RANDOM_ENGINE;
+#else
+	using Engine = std::mt19937;
+#endif
+
+	// Reproducible seeding
+	// By default every run is seeded differently, which makes a bug seen in one run hard to chase down.
+	// Every run therefore has a single 64-bit process seed:
+	// * If the RANDOM_SEED environment variable is set (e.g. RANDOM_SEED=12345), that is the process seed.
+	// * Otherwise the process seed is drawn once from std::random_device (mixed with the clock), so runs still differ.
+	// Either way, every engine this header creates (engine(), bulkEngine(), Random::stream(i)) is derived from it, so
+	// logging Random::processSeed() at startup is enough to replay any run later with RANDOM_SEED.
+	// Random::reseed(seed) sets the process seed from code instead.
+	namespace detail
+	{
+		inline std::uint64_t& processSeedState()
+		{
+			static std::uint64_t s_seed{ [] {
+				if (const char* text{ std::getenv("RANDOM_SEED") }; text && *text)
+					return static_cast<std::uint64_t>(std::strtoull(text, nullptr, 0));
+
+				std::random_device rd{};
+				const auto clock{ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) };
+				return ((static_cast<std::uint64_t>(rd()) << 32) | rd()) ^ clock; // the clock in case random_device is deterministic
+			}() };
+
+			return s_seed;
+		}
+
+		// The engines this header creates itself get fixed stream numbers, so the same seed gives the same draws
+		// however the program first touches them (and whether it was set by RANDOM_SEED, reseed() or drawn at random)
+		constexpr std::uint64_t engineStream{ 0 };
+		constexpr std::uint64_t bulkEngineStream{ 1 };
+		constexpr std::uint64_t implicitStreams{ 2 };
+
+#ifdef RANDOM_PER_THREAD
+		// With per-thread engines, thread number t uses streams engineStream + t * implicitStreams and so on.
+		// Threads are numbered in the order they first draw, so the thread that draws first (normally main) is 0.
+		inline std::atomic<std::uint64_t> nextThreadNumber{ 0 };
+
+		inline std::uint64_t threadNumber()
+		{
+			thread_local const std::uint64_t t_number{ nextThreadNumber++ };
+			return t_number;
+		}
+
+		inline std::uint64_t implicitStream(std::uint64_t stream) { return stream + threadNumber() * implicitStreams; }
+#else
+		inline std::uint64_t implicitStream(std::uint64_t stream) { return stream; }
+#endif
+	}
+
+	inline std::uint64_t processSeed()
+	{
+		return detail::processSeedState();
+	}
+
+	// Returns an engine of type E deterministically seeded from (seed, stream).
+	// Different streams with the same seed never overlap:
+	// * engines with a jump() function (Xoshiro256ss) are jumped 2^128 draws per stream
+	// * engines that take a stream number (Pcg32) get a different increment, so a different sequence altogether
+	// * anything else (std::mt19937, ...) is seeded from a std::seed_seq of both values, and overlap is vanishingly unlikely
+	template <typename E = Engine>
+	E seeded(std::uint64_t seed, std::uint64_t stream = 0)
+	{
+		if constexpr (requires(E e) { e.jump(); })
+		{
+			E engine{ seed };
+			for (std::uint64_t i{ 0 }; i < stream; ++i)
+				engine.jump();
+			return engine;
+		}
+		else if constexpr (std::is_constructible_v<E, std::uint64_t, std::uint64_t>)
+			return E{ seed, stream };
+		else
+		{
+			std::seed_seq ss{
+				static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+				static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) };
+			return E{ ss };
+		}
+	}
+
+	// Returns the engine for parallel worker number index, derived from the process seed.
+	// Give each worker its own stream and the run is reproducible no matter how the threads are scheduled.
+	// Sample call: auto engine{ Random::stream(workerIndex) };
+	template <typename E = Engine>
+	E stream(std::uint64_t index)
 	{
-		std::random_device rd{};
+		return seeded<E>(processSeed(), index);
+	}
 
-		// Create seed_seq with clock and 7 random numbers from std::random_device
-		std::seed_seq ss{
-			static_cast<std::seed_seq::result_type>(std::chrono::steady_clock::now().time_since_epoch().count()),
-				rd(), rd(), rd(), rd(), rd(), rd(), rd() };
+	// Returns a seeded engine (a Mersenne Twister unless RANDOM_ENGINE says otherwise)
+	// The engine is derived from the process seed and stream, so engines that should differ need different streams
+	// (engine() and bulkEngine() use 0 and 1, see detail::engineStream).
+	template <typename E = Engine>
+	E generate(std::uint64_t stream = detail::engineStream)
+	{
+		// The seed is scrambled first so these engines never share a stream with Random::stream(index).
+		return seeded<E>(SplitMix64{ processSeed() }(), stream);
+	}
 
-		return std::mt19937{ ss };
+	// Here's our global engine.
+	// It used to be a global variable initialized with generate(), which meant every program that included this header
+	// paid for std::random_device reads and seeding before main() even started, whether it drew a number or not.
+	// Now it lives in a static local variable, so it is seeded the first time it is used. After that, the only cost
+	// left is the compiler's "already initialized?" guard check: one load and a branch that is always predicted correctly.
+	// If RANDOM_PER_THREAD is defined before this header is included, each thread instead gets its own
+	// independently seeded engine (thread_local), so Random::get can be called from several threads
+	// without a data race and without the threads fighting over the same cache lines.
+	inline Engine& engine()
+	{
+#ifdef RANDOM_PER_THREAD
+		thread_local Engine s_engine{ generate(detail::implicitStream(detail::engineStream)) }; // seeded the first time each thread uses it
+#else
+		static Engine s_engine{ generate(detail::implicitStream(detail::engineStream)) }; // seeded the first time anyone uses it
+#endif
+		return s_engine;
 	}
 
-	// Here's our global std::mt19937 object.
-	// The inline keyword means we only have one global instance for our whole program.
-	inline std::mt19937 mt{ generate() }; // generates a seeded std::mt19937 and copies it into our global object
+	// Random::mt used to be the global engine object itself. It's now a stand-in that forwards to engine(),
+	// so existing code such as std::shuffle(v.begin(), v.end(), Random::mt) still works.
+	// It has no state, so it costs nothing at startup.
+	struct LazyEngine
+	{
+		using result_type = Engine::result_type;
+		static constexpr result_type min() { return Engine::min(); }
+		static constexpr result_type max() { return Engine::max(); }
+
+		result_type operator()() const { return engine()(); }
+	};
+
+	inline LazyEngine mt{};
+
+	// Bounded integers
+	// std::uniform_int_distribution needs a division (and in libstdc++ often more than one) on every draw.
+	// Instead, we multiply a 32-bit random word by the size of the range and keep the high half
+	// (Lemire's method, https://arxiv.org/abs/1805.10941). Only the draws that land in the small biased
+	// slice at the bottom of the range need a modulo, and only those few ever draw again.
+	// The results only depend on the engine, so they're the same with every standard library.
+	namespace detail
+	{
+		// Engines whose output covers every 32-bit or 64-bit value can feed Lemire's method directly.
+		// Narrower engines (like Lcg16) fall back to std::uniform_int_distribution.
+		template <typename E>
+		constexpr bool isFullWidth{ E::min() == 0
+			&& (E::max() == 0xFFFFFFFF || E::max() == 0xFFFFFFFFFFFFFFFF) };
+
+		// Adapts a full-width engine to the next32()/next64() interface used by the bounded functions below
+		template <typename E>
+		class EngineWords
+		{
+		public:
+			constexpr explicit EngineWords(E& engine) : m_engine{ engine } {}
+
+			constexpr std::uint32_t next32()
+			{
+				if constexpr (E::max() == 0xFFFFFFFF)
+					return static_cast<std::uint32_t>(m_engine());
+				else
+					return static_cast<std::uint32_t>(m_engine() >> 32); // the high bits are the best ones
+			}
+
+			constexpr std::uint64_t next64()
+			{
+				if constexpr (E::max() == 0xFFFFFFFF)
+				{
+					const std::uint64_t high{ m_engine() };
+					return (high << 32) | m_engine();
+				}
+				else
+					return m_engine();
+			}
+
+		private:
+			E& m_engine;
+		};
+
+		// Unbiased value in [0, range)
+		template <typename Source>
+		constexpr std::uint32_t bounded32(Source& source, std::uint32_t range)
+		{
+			std::uint64_t m{ static_cast<std::uint64_t>(source.next32()) * range };
+			if (static_cast<std::uint32_t>(m) < range)
+			{
+				const std::uint32_t threshold{ static_cast<std::uint32_t>(-range) % range };
+				while (static_cast<std::uint32_t>(m) < threshold)
+					m = static_cast<std::uint64_t>(source.next32()) * range;
+			}
+			return static_cast<std::uint32_t>(m >> 32);
+		}
+
+		// Unbiased value in [0, maxOffset] (note: inclusive) for ranges too wide for bounded32, using mask-and-reject
+		template <typename Source>
+		constexpr std::uint64_t bounded64(Source& source, std::uint64_t maxOffset)
+		{
+			std::uint64_t mask{ maxOffset };
+			mask |= mask >> 1;
+			mask |= mask >> 2;
+			mask |= mask >> 4;
+			mask |= mask >> 8;
+			mask |= mask >> 16;
+			mask |= mask >> 32;
+
+			std::uint64_t x{};
+			do
+			{
+				x = source.next64() & mask;
+			} while (x > maxOffset);
+			return x;
+		}
+
+		// Same as bounded32, but the range is known at compile time, so the rejection threshold is too
+		// (and for power-of-two ranges the rejection loop disappears entirely)
+		template <std::uint32_t range, typename Source>
+		constexpr std::uint32_t bounded32(Source& source)
+		{
+			constexpr std::uint32_t threshold{ static_cast<std::uint32_t>(-range) % range };
+
+			std::uint64_t m{ static_cast<std::uint64_t>(source.next32()) * range };
+			while (static_cast<std::uint32_t>(m) < threshold)
+				m = static_cast<std::uint64_t>(source.next32()) * range;
+			return static_cast<std::uint32_t>(m >> 32);
+		}
+
+		// Unbiased value in [0, maxOffset] for any range, picking the cheapest method that fits
+		template <typename Source>
+		constexpr std::uint64_t boundedOffset(Source& source, std::uint64_t maxOffset)
+		{
+			if (maxOffset < 0xFFFFFFFF)
+				return bounded32(source, static_cast<std::uint32_t>(maxOffset + 1));
+			return bounded64(source, maxOffset);
+		}
+
+		// max - min, and min + offset, for any integral T.
+		// They work in unsigned so max - min can't overflow (e.g. for INT_MIN and INT_MAX).
+		template <std::integral T>
+		constexpr std::uint64_t offsetBetween(T min, T max)
+		{
+			using U = std::make_unsigned_t<T>;
+			return static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+		}
+
+		template <std::integral T>
+		constexpr T addOffset(T min, std::uint64_t offset)
+		{
+			using U = std::make_unsigned_t<T>;
+			return static_cast<T>(static_cast<U>(min) + static_cast<U>(offset));
+		}
+
+		// Unbiased value in [min, max] (inclusive) for any integral T, drawn from source
+		template <std::integral T, typename Source>
+		constexpr T boundedBetween(Source& source, T min, T max)
+		{
+			return addOffset(min, boundedOffset(source, offsetBetween(min, max)));
+		}
+
+		// Random value between [min, max] (inclusive) drawn from engine
+		template <std::integral T, typename E>
+		constexpr T uniform(E& engine, T min, T max)
+		{
+			if constexpr (isFullWidth<E>)
+			{
+				EngineWords<E> words{ engine };
+				return boundedBetween(words, min, max);
+			}
+			else
+				return std::uniform_int_distribution<T>{ min, max }(engine);
+		}
+	}
 
 	// Generate a random int between [min, max] (inclusive)
         // * also handles cases where the two arguments have different types but can be converted to int
 	inline int get(int min, int max)
 	{
-		return std::uniform_int_distribution{min, max}(mt);
+		return detail::uniform(engine(), min, max);
 	}
 
 	// The following function templates can be used to generate random numbers in other cases
@@ -52,7 +538,7 @@ namespace Random
 	template <typename T>
 	T get(T min, T max)
 	{
-		return std::uniform_int_distribution<T>{min, max}(mt);
+		return detail::uniform(engine(), min, max);
 	}
 
 	// Generate a random value between [min, max] (inclusive)
@@ -67,6 +553,559 @@ namespace Random
 	{
 		return get<R>(static_cast<R>(min), static_cast<R>(max));
 	}
+
+	// Generate a random value between [min, max] (inclusive), where min and max are compile-time constants
+	// * returns the same values as Random::get(min, max) would for the same engine state, just a little faster
+	// * return value has the same type as min and max
+	// Sample call: Random::get<1, 6>();             // returns int
+	template <auto min, auto max>
+		requires std::integral<decltype(min)> && std::same_as<decltype(min), decltype(max)> && (min <= max)
+	decltype(min) get()
+	{
+		constexpr std::uint64_t maxOffset{ detail::offsetBetween(min, max) };
+
+		if constexpr (detail::isFullWidth<Engine> && maxOffset < 0xFFFFFFFF)
+		{
+			detail::EngineWords<Engine> words{ engine() };
+			return detail::addOffset(min, detail::bounded32<static_cast<std::uint32_t>(maxOffset + 1)>(words));
+		}
+		else
+			return get(min, max);
+	}
+
+	// Bulk generation
+	// Random::get builds a distribution and draws one value per call, which is fine for games but slow when
+	// we need millions of values at once. Random::fill writes a whole buffer in one call instead.
+
+	// Four independent xoshiro256** generators (https://prng.di.unimi.it/) stepped in lockstep.
+	// The state is stored lane-by-lane (m_s[word][lane]) so the inner loop over lanes has no dependencies
+	// between iterations, and the compiler can turn it into SSE2/AVX2 instructions.
+	class Xoshiro256x4
+	{
+	public:
+		static constexpr std::size_t lanes{ 4 };
+
+		explicit Xoshiro256x4(std::seed_seq& ss)
+		{
+			const auto words{ detail::seedWords<4 * lanes>(ss) };
+			for (std::size_t word{ 0 }; word < 4; ++word)
+				for (std::size_t lane{ 0 }; lane < lanes; ++lane)
+					m_s[word][lane] = words[word * lanes + lane];
+
+			// xoshiro must never have an all-zero state
+			for (std::size_t lane{ 0 }; lane < lanes; ++lane)
+				if ((m_s[0][lane] | m_s[1][lane] | m_s[2][lane] | m_s[3][lane]) == 0)
+					m_s[0][lane] = 0x9E3779B97F4A7C15;
+		}
+
+		// Writes count 64-bit values to out (count must be a multiple of lanes)
+		void generate(std::uint64_t* out, std::size_t count)
+		{
+			for (std::size_t i{ 0 }; i < count; i += lanes)
+			{
+				for (std::size_t lane{ 0 }; lane < lanes; ++lane)
+				{
+					out[i + lane] = detail::rotl(m_s[1][lane] * 5, 7) * 9;
+
+					const std::uint64_t t{ m_s[1][lane] << 17 };
+					m_s[2][lane] ^= m_s[0][lane];
+					m_s[3][lane] ^= m_s[1][lane];
+					m_s[1][lane] ^= m_s[2][lane];
+					m_s[0][lane] ^= m_s[3][lane];
+					m_s[2][lane] ^= t;
+					m_s[3][lane] = detail::rotl(m_s[3][lane], 45);
+				}
+			}
+		}
+
+	private:
+		std::uint64_t m_s[4][lanes]{};
+	};
+
+	// The engine used by Random::fill, seeded on first use just like engine()
+	inline Xoshiro256x4& bulkEngine()
+	{
+#ifdef RANDOM_PER_THREAD
+		thread_local Xoshiro256x4 s_bulk{ generate<Xoshiro256x4>(detail::implicitStream(detail::bulkEngineStream)) };
+#else
+		static Xoshiro256x4 s_bulk{ generate<Xoshiro256x4>(detail::implicitStream(detail::bulkEngineStream)) };
+#endif
+		return s_bulk;
+	}
+
+	// Defining RANDOM_EAGER_INIT brings back the old behavior of seeding both engines before main() runs
+	// (benchmarks/random startup.cpp uses it to measure the difference)
+#ifdef RANDOM_EAGER_INIT
+	inline Engine& eagerEngine{ engine() };
+	inline Xoshiro256x4& eagerBulkEngine{ bulkEngine() };
+#endif
+
+	// Sets the process seed, and reseeds engine() and bulkEngine() (on the calling thread) from it.
+	// Afterwards they draw exactly what they would have in a run started with RANDOM_SEED=seed, every time it's called.
+	// Call it before starting any threads; engines created afterwards (e.g. per-thread ones) are derived from it too.
+	inline void reseed(std::uint64_t seed)
+	{
+		detail::processSeedState() = seed;
+
+		engine() = generate(detail::implicitStream(detail::engineStream));
+		bulkEngine() = generate<Xoshiro256x4>(detail::implicitStream(detail::bulkEngineStream));
+	}
+
+	namespace detail
+	{
+		// Hands out raw random words, refilling a small buffer from the bulk engine 64 values (128 words) at a time
+		class BulkWords
+		{
+		public:
+			explicit BulkWords(Xoshiro256x4& engine) : m_engine{ engine } {}
+
+			std::uint32_t next32()
+			{
+				if (m_pos == m_words.size())
+				{
+					std::array<std::uint64_t, 64> values{};
+					m_engine.generate(values.data(), values.size());
+					std::memcpy(m_words.data(), values.data(), sizeof(values));
+					m_pos = 0;
+				}
+				return m_words[m_pos++];
+			}
+
+			std::uint64_t next64()
+			{
+				const std::uint64_t high{ next32() };
+				return (high << 32) | next32();
+			}
+
+		private:
+			Xoshiro256x4& m_engine;
+			std::array<std::uint32_t, 128> m_words{};
+			std::size_t m_pos{ m_words.size() };
+		};
+	}
+
+	// Fill out with random integers between [min, max] (inclusive)
+	// out can be a span of a std::vector, std::array or C array, and min and max are converted to its element type.
+	// Sample call: Random::fill(std::span{ rolls }, 1, 6);
+	template <std::integral T, std::size_t Extent>
+	void fill(std::span<T, Extent> out, std::type_identity_t<T> min, std::type_identity_t<T> max)
+	{
+		detail::BulkWords words{ bulkEngine() };
+		for (T& value : out)
+			value = detail::boundedBetween(words, min, max);
+	}
+
+	// Fill out with random doubles in [min, max) (like std::uniform_real_distribution, rounding can rarely give max)
+	// Uses the top 53 bits of each 64-bit value, so every representable value in [0, 1) step 2^-53 is equally likely
+	inline void fill(std::span<double> out, double min, double max)
+	{
+		const double scale{ max - min };
+		Xoshiro256x4& bulk{ bulkEngine() };
+		std::array<std::uint64_t, 64> buffer{};
+
+		for (std::size_t i{ 0 }; i < out.size(); i += buffer.size())
+		{
+			bulk.generate(buffer.data(), buffer.size());
+
+			const std::size_t count{ std::min(buffer.size(), out.size() - i) };
+			for (std::size_t j{ 0 }; j < count; ++j)
+				out[i + j] = min + static_cast<double>(buffer[j] >> 11) * 0x1.0p-53 * scale;
+		}
+	}
+
+	// Fill out with random floats in [min, max)
+	// Each 64-bit value provides two floats (24 bits each)
+	inline void fill(std::span<float> out, float min, float max)
+	{
+		const float scale{ max - min };
+		Xoshiro256x4& bulk{ bulkEngine() };
+		std::array<std::uint64_t, 64> buffer{};
+
+		for (std::size_t i{ 0 }; i < out.size(); i += buffer.size() * 2)
+		{
+			bulk.generate(buffer.data(), buffer.size());
+
+			const std::size_t count{ std::min(buffer.size() * 2, out.size() - i) };
+			for (std::size_t j{ 0 }; j < count; ++j)
+			{
+				const std::uint64_t bits{ j % 2 == 0 ? buffer[j / 2] >> 40 : (buffer[j / 2] >> 8) & 0xFFFFFF };
+				out[i + j] = min + static_cast<float>(bits) * 0x1.0p-24f * scale;
+			}
+		}
+	}
+
+	// Normal and exponential distributions
+	// std::normal_distribution and std::exponential_distribution are slow, and each standard library implements them
+	// differently, so the same seed gives different values with libstdc++, libc++ and MSVC.
+	// These use the ziggurat method (Marsaglia & Tsang 2000, with Doornik's 2005 fix for the normal version):
+	// about 99% of draws cost one random 64-bit value, a table lookup and a multiply.
+	// The tables are computed at compile time and the rare slow paths use the exp/log/sqrt below, which are built
+	// only from +, -, * and / (exactly rounded in IEEE 754), so results only depend on the engine.
+	namespace detail
+	{
+		// e^x for the ziggurat (accurate to a few ulps, and the same on every platform)
+		constexpr double exp(double x)
+		{
+			constexpr double ln2Hi{ 6.93147180369123816490e-01 };
+			constexpr double ln2Lo{ 1.90821492927058770002e-10 };
+
+			// x = k * ln2 + r, with |r| <= ln2 / 2
+			const double kd{ x * 1.44269504088896338700 };
+			const auto k{ static_cast<int>(kd < 0 ? kd - 0.5 : kd + 0.5) };
+			const double r{ (x - k * ln2Hi) - k * ln2Lo };
+
+			double term{ 1.0 };
+			double sum{ 1.0 };
+			for (int n{ 1 }; n < 24; ++n)
+			{
+				term *= r / n;
+				sum += term;
+			}
+
+			// scale by 2^k one doubling at a time (each step is exact)
+			for (int i{ 0 }; i < k; ++i)
+				sum *= 2.0;
+			for (int i{ 0 }; i > k; --i)
+				sum *= 0.5;
+			return sum;
+		}
+
+		// Natural log of x > 0 (accurate to a few ulps, and the same on every platform)
+		constexpr double log(double x)
+		{
+			constexpr double ln2{ 0.69314718055994530942 };
+
+			// x = m * 2^e, with m in [sqrt(1/2), sqrt(2))
+			int e{ 0 };
+			while (x > 1.4142135623730951)
+			{
+				x *= 0.5;
+				++e;
+			}
+			while (x < 0.7071067811865476)
+			{
+				x *= 2.0;
+				--e;
+			}
+
+			// log(m) = 2 atanh((m - 1) / (m + 1))
+			const double s{ (x - 1.0) / (x + 1.0) };
+			const double s2{ s * s };
+			double power{ s };
+			double sum{ 0.0 };
+			for (int n{ 1 }; n < 40; n += 2)
+			{
+				sum += power / n;
+				power *= s2;
+			}
+			return 2.0 * sum + e * ln2;
+		}
+
+		// Square root of x >= 0 by Newton's method (only used to build the tables)
+		constexpr double sqrt(double x)
+		{
+			if (x == 0.0)
+				return 0.0;
+
+			double guess{ x > 1.0 ? x : 1.0 };
+			for (int i{ 0 }; i < 100; ++i)
+			{
+				const double next{ 0.5 * (guess + x / guess) };
+				if (next >= guess)
+					break;
+				guess = next;
+			}
+			return guess;
+		}
+
+		// The ziggurat: layers equal-area strips under the density, layer i being [0, x[i]] wide.
+		// ratio[i] = x[i + 1] / x[i] is the part of layer i that lies entirely under the curve.
+		template <std::size_t layers>
+		struct Ziggurat
+		{
+			std::array<double, layers + 1> x{};
+			std::array<double, layers> ratio{};
+			std::array<double, layers + 1> density{}; // f(x[i]), for the wedge test
+		};
+
+		// Doornik's ZIGNOR tables for the standard normal (128 layers)
+		inline constexpr double normalTail{ 3.442619855899 };
+		inline constexpr Ziggurat<128> normalZiggurat{ [] {
+			constexpr double area{ 9.91256303526217e-3 };
+			Ziggurat<128> z{};
+
+			double f{ detail::exp(-0.5 * normalTail * normalTail) };
+			z.x[0] = area / f;
+			z.x[1] = normalTail;
+			for (std::size_t i{ 2 }; i < 128; ++i)
+			{
+				z.x[i] = detail::sqrt(-2.0 * detail::log(area / z.x[i - 1] + f));
+				f = detail::exp(-0.5 * z.x[i] * z.x[i]);
+			}
+			z.x[128] = 0.0;
+
+			for (std::size_t i{ 0 }; i < 128; ++i)
+				z.ratio[i] = z.x[i + 1] / z.x[i];
+			for (std::size_t i{ 0 }; i <= 128; ++i)
+				z.density[i] = detail::exp(-0.5 * z.x[i] * z.x[i]);
+			return z;
+		}() };
+
+		// Marsaglia & Tsang's tables for the standard exponential (256 layers)
+		inline constexpr double exponentialTail{ 7.69711747013104972 };
+		inline constexpr Ziggurat<256> exponentialZiggurat{ [] {
+			constexpr double area{ 3.949659822581572e-3 };
+			Ziggurat<256> z{};
+
+			double f{ detail::exp(-exponentialTail) };
+			z.x[0] = area / f;
+			z.x[1] = exponentialTail;
+			for (std::size_t i{ 2 }; i < 256; ++i)
+			{
+				z.x[i] = -detail::log(area / z.x[i - 1] + f);
+				f = detail::exp(-z.x[i]);
+			}
+			z.x[256] = 0.0;
+
+			for (std::size_t i{ 0 }; i < 256; ++i)
+				z.ratio[i] = z.x[i + 1] / z.x[i];
+			for (std::size_t i{ 0 }; i <= 256; ++i)
+				z.density[i] = detail::exp(-z.x[i]);
+			return z;
+		}() };
+
+		// A double in [0, 1) from the top 53 bits of a 64-bit word
+		constexpr double unit(std::uint64_t bits)
+		{
+			return static_cast<double>(bits >> 11) * 0x1.0p-53;
+		}
+
+		// A double in (0, 1], for logs
+		constexpr double unitNonZero(std::uint64_t bits)
+		{
+			return static_cast<double>((bits >> 11) + 1) * 0x1.0p-53;
+		}
+
+		// One standard normal value. The low 7 bits of each word pick the layer and the top 53 make the
+		// position within it, so the two never share bits.
+		template <typename Source>
+		double standardNormal(Source& source)
+		{
+			const Ziggurat<128>& z{ normalZiggurat };
+			while (true)
+			{
+				const std::uint64_t bits{ source.next64() };
+				const std::size_t i{ bits & 0x7F };
+				const double u{ 2.0 * unit(bits) - 1.0 };
+
+				if ((u < 0 ? -u : u) < z.ratio[i]) // entirely under the curve: the common case
+					return u * z.x[i];
+
+				if (i == 0) // the base layer's overhang is the tail beyond normalTail
+				{
+					double x{};
+					double y{};
+					do
+					{
+						x = detail::log(unitNonZero(source.next64())) / normalTail;
+						y = detail::log(unitNonZero(source.next64()));
+					} while (-2.0 * y < x * x);
+					return u < 0 ? x - normalTail : normalTail - x;
+				}
+
+				// in the wedge between layers: accept if a point under the strip is also under the curve
+				const double x{ u * z.x[i] };
+				const double y{ z.density[i] + unit(source.next64()) * (z.density[i + 1] - z.density[i]) };
+				if (y < detail::exp(-0.5 * x * x))
+					return x;
+			}
+		}
+
+		// One standard exponential value, using the low 8 bits for the layer
+		template <typename Source>
+		double standardExponential(Source& source)
+		{
+			const Ziggurat<256>& z{ exponentialZiggurat };
+			while (true)
+			{
+				const std::uint64_t bits{ source.next64() };
+				const std::size_t i{ bits & 0xFF };
+				const double u{ unit(bits) };
+
+				if (u < z.ratio[i])
+					return u * z.x[i];
+
+				if (i == 0) // the exponential's tail is just another exponential, shifted
+					return exponentialTail - detail::log(unitNonZero(source.next64()));
+
+				const double x{ u * z.x[i] };
+				const double y{ z.density[i] + unit(source.next64()) * (z.density[i + 1] - z.density[i]) };
+				if (y < detail::exp(-x))
+					return x;
+			}
+		}
+
+		// Adapts engines narrower than 64 bits (like Lcg16) by stitching their output together.
+		// (Only the full-width engines are guaranteed to give the same results with every standard library.)
+		template <typename E>
+		class AnyEngineWords
+		{
+		public:
+			explicit AnyEngineWords(E& engine) : m_engine{ engine } {}
+
+			std::uint64_t next64()
+			{
+				if constexpr (isFullWidth<E>)
+					return EngineWords<E>{ m_engine }.next64();
+				else
+					return std::uniform_int_distribution<std::uint64_t>{}(m_engine);
+			}
+
+		private:
+			E& m_engine;
+		};
+	}
+
+	// Generate a normally distributed double (bell curve) with the given mean and standard deviation
+	// Sample call: Random::normal(100.0, 15.0);
+	inline double normal(double mean = 0.0, double stddev = 1.0)
+	{
+		detail::AnyEngineWords<Engine> words{ engine() };
+		return mean + stddev * detail::standardNormal(words);
+	}
+
+	// Generate an exponentially distributed double (e.g. the time between random events) with the given rate
+	// Sample call: Random::exponential(0.5);   // mean of 2
+	inline double exponential(double lambda = 1.0)
+	{
+		detail::AnyEngineWords<Engine> words{ engine() };
+		return detail::standardExponential(words) / lambda;
+	}
+
+	// Fill out with normally distributed doubles, drawing from the bulk engine like Random::fill
+	inline void fillNormal(std::span<double> out, double mean = 0.0, double stddev = 1.0)
+	{
+		detail::BulkWords words{ bulkEngine() };
+		for (double& value : out)
+			value = mean + stddev * detail::standardNormal(words);
+	}
+
+	// Fill out with exponentially distributed doubles, drawing from the bulk engine like Random::fill
+	inline void fillExponential(std::span<double> out, double lambda = 1.0)
+	{
+		detail::BulkWords words{ bulkEngine() };
+		for (double& value : out)
+			value = detail::standardExponential(words) / lambda;
+	}
+
+	// Compile-time tables
+	// Returns count random values between [min, max] (inclusive), computed entirely by the compiler.
+	// Stored in a constexpr variable, the values are baked into the program's read-only data and cost nothing at runtime,
+	// and the same seed always gives the same table (handy for test vectors and fuzz seeds).
+	// E can be any engine with a constexpr seed constructor and full-width output: Lcg32, Pcg32, SplitMix64 or Xoshiro256ss.
+	// Sample call: constexpr auto hitpoints{ Random::table<int, 64>(42, 1, 100) };
+	template <typename T, std::size_t count, typename E = Lcg32>
+	consteval std::array<T, count> table(std::uint64_t seed, T min, T max)
+	{
+		static_assert(detail::isFullWidth<E>, "Random::table needs an engine with 32 or 64 bits of output");
+
+		E engine{ seed };
+		std::array<T, count> values{};
+		for (T& value : values)
+			value = detail::uniform(engine, min, max);
+		return values;
+	}
+
+	// Counter-based (stateless) generation
+	// Every engine above is a sequence: to get the 1000th value you have to compute the 999 before it, and the state
+	// has to live somewhere. Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC11) is
+	// instead a function of (key, counter), so value i can be computed on its own, by any thread, in any order.
+	// A parallel loop filling element i with Random::at(seed, stream, i) gives the same buffer with 1 thread or 64.
+	namespace detail
+	{
+		using PhiloxBlock = std::array<std::uint32_t, 4>;
+
+		constexpr PhiloxBlock philox4x32(PhiloxBlock counter, std::uint32_t key0, std::uint32_t key1)
+		{
+			for (int round{ 0 }; round < 10; ++round)
+			{
+				const std::uint64_t product0{ static_cast<std::uint64_t>(0xD2511F53) * counter[0] };
+				const std::uint64_t product1{ static_cast<std::uint64_t>(0xCD9E8D57) * counter[2] };
+
+				counter = {
+					static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key0,
+					static_cast<std::uint32_t>(product1),
+					static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key1,
+					static_cast<std::uint32_t>(product0) };
+
+				key0 += 0x9E3779B9;
+				key1 += 0xBB67AE85;
+			}
+			return counter;
+		}
+
+		// The block of four 32-bit values for (seed, stream, index)
+		constexpr PhiloxBlock philoxBlock(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+		{
+			return philox4x32(
+				{ static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+				  static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32) },
+				static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32));
+		}
+
+		// Serves the words of one Philox block to the bounded functions.
+		// Running out takes four rejections in a row, which almost never happens; if it does, the block is encrypted again.
+		class PhiloxWords
+		{
+		public:
+			constexpr PhiloxWords(PhiloxBlock block, std::uint64_t seed) : m_block{ block }, m_seed{ seed } {}
+
+			constexpr std::uint32_t next32()
+			{
+				if (m_pos == m_block.size())
+				{
+					m_block = philox4x32(m_block, static_cast<std::uint32_t>(m_seed), static_cast<std::uint32_t>(m_seed >> 32));
+					m_pos = 0;
+				}
+				return m_block[m_pos++];
+			}
+
+			constexpr std::uint64_t next64()
+			{
+				const std::uint64_t high{ next32() };
+				return (high << 32) | next32();
+			}
+
+		private:
+			PhiloxBlock m_block{};
+			std::uint64_t m_seed{};
+			std::size_t m_pos{ 0 };
+		};
+	}
+
+	// Returns random value number index of stream stream under seed seed.
+	// There's no state involved, so this can be called from any number of threads at once.
+	// Sample call: buffer[i] = Random::at(seed, 0, i);
+	constexpr std::uint64_t at(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+	{
+		const detail::PhiloxBlock block{ detail::philoxBlock(seed, stream, index) };
+		return (static_cast<std::uint64_t>(block[0]) << 32) | block[1];
+	}
+
+	// Returns random value number index of stream stream under seed seed, between [min, max] (inclusive)
+	// Sample call: rolls[i] = Random::at(seed, 0, i, 1, 6);
+	template <std::integral T>
+	T at(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, T min, T max)
+	{
+		detail::PhiloxWords words{ detail::philoxBlock(seed, stream, index), seed };
+		return detail::boundedBetween(words, min, max);
+	}
+
+	// Returns random value number index of stream stream under seed seed, as a double in [0, 1)
+	constexpr double atUnit(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+	{
+		return static_cast<double>(at(seed, stream, index) >> 11) * 0x1.0p-53;
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef ROUNDARENA_H
+#define ROUNDARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+// A bump allocator for objects that only live for one round (of a game, a batch job, ...).
+// Allocating just moves a pointer forward in one big buffer, deallocating does nothing, and endRound() makes the
+// whole buffer available again in O(1), however many objects were allocated from it.
+// Use it through std::pmr containers and strings:
+//     RoundArena arena{};
+//     std::pmr::vector<std::pmr::string> names{ arena.resource() };
+//     ...
+//     names = {}; // whatever lives in the arena must be gone before the round ends
+//     arena.endRound();
+// If a round needs more than the buffer holds, the overflow comes from the global heap, and the buffer is grown
+// at the end of that round so the next rounds fit.
+class RoundArena
+{
+public:
+    explicit RoundArena(std::size_t bytes = 1 << 20) : m_buffer(bytes)
+    {
+        start();
+    }
+
+    RoundArena(const RoundArena&) = delete;
+    RoundArena& operator=(const RoundArena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &*m_bump; }
+
+    // Frees everything allocated this round at once
+    void endRound()
+    {
+        // the old resource must go before the buffer it points into grows (and maybe moves)
+        m_bump.reset(); // gives any overflow back to the heap
+        if (m_overflow.bytes > 0)
+            m_buffer.resize(m_buffer.size() + 2 * m_overflow.bytes);
+        start();
+    }
+
+    std::size_t capacity() const { return m_buffer.size(); }
+
+private:
+    // Passes requests on to the global heap, remembering how much was asked for
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t bytes{ 0 };
+
+    private:
+        void* do_allocate(std::size_t size, std::size_t alignment) override
+        {
+            bytes += size;
+            return std::pmr::new_delete_resource()->allocate(size, alignment);
+        }
+
+        void do_deallocate(void* p, std::size_t size, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    std::vector<std::byte> m_buffer{};
+    CountingResource m_overflow{};
+    std::optional<std::pmr::monotonic_buffer_resource> m_bump{};
+
+    void start()
+    {
+        m_overflow.bytes = 0;
+        m_bump.emplace(m_buffer.data(), m_buffer.size(), &m_overflow);
+    }
+};
+
+#endif
@@ -0,0 +1,191 @@
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include "parallel.h"
+#include "random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Sampling and shuffling on top of random.h
+// std::shuffle(v.begin(), v.end(), Random::mt) needs the whole array in memory and runs on one thread.
+// This adds:
+// * Random::sample(k, n)        k distinct indices out of n, in O(k) time and memory (Floyd's algorithm)
+// * Random::Reservoir<T>        a uniform sample of k items from a stream of unknown length (Li's Algorithm L)
+// * Random::parallelShuffle     a shuffle of huge arrays that uses every core (Sanders' scatter shuffle)
+namespace Random::inline RANDOM_CONFIG_NAMESPACE // the same settings as random.h, since these call Random::get
+{
+    // Returns k distinct values in [0, n), every k-subset being equally likely (in no particular order).
+    // Floyd's algorithm only ever looks at k candidates, so n can be as large as you like.
+    // Sample call: Random::sample(5, 1'000'000'000);
+    inline std::vector<std::uint64_t> sample(std::size_t k, std::uint64_t n)
+    {
+        k = static_cast<std::size_t>(std::min<std::uint64_t>(k, n));
+
+        std::vector<std::uint64_t> chosen{};
+        chosen.reserve(k);
+        std::unordered_set<std::uint64_t> seen{};
+        seen.reserve(k);
+
+        for (std::uint64_t j{ n - k }; j < n; ++j)
+        {
+            const std::uint64_t t{ get<std::uint64_t>(0, j) };
+            const std::uint64_t pick{ seen.insert(t).second ? t : j }; // if t was taken, j can't have been
+            if (pick == j)
+                seen.insert(j);
+            chosen.push_back(pick);
+        }
+
+        return chosen;
+    }
+
+    // Keeps a uniform random sample of up to k of the items passed to add(), without storing the rest.
+    // Uses Algorithm L (Li, 1994): instead of drawing a random number for every item, it works out how many
+    // items to skip before the next replacement, so a long stream costs O(k log(n / k)) draws in total.
+    template <typename T>
+    class Reservoir
+    {
+    public:
+        explicit Reservoir(std::size_t k) : m_k{ k }
+        {
+            m_items.reserve(k);
+        }
+
+        void add(const T& item)
+        {
+            if (m_k == 0) // a sample of nothing: there's no slot to replace
+                return;
+
+            if (m_items.size() < m_k)
+            {
+                m_items.push_back(item);
+                if (m_items.size() == m_k)
+                    startSkipping();
+                return;
+            }
+
+            if (m_skip > 0)
+            {
+                --m_skip;
+                return;
+            }
+
+            m_items[static_cast<std::size_t>(get<std::uint64_t>(0, m_k - 1))] = item;
+            m_w *= std::exp(std::log(openUnit()) / static_cast<double>(m_k));
+            nextSkip();
+        }
+
+        // The sample so far (all the items if fewer than k have been added)
+        const std::vector<T>& items() const { return m_items; }
+
+    private:
+        std::size_t m_k{};
+        std::vector<T> m_items{};
+        double m_w{};
+        std::uint64_t m_skip{};
+
+        // A double in (0, 1), so its log is finite and nonzero
+        static double openUnit()
+        {
+            return (static_cast<double>(get<std::uint64_t>(0, (1ull << 53) - 2)) + 1.0) * 0x1.0p-53;
+        }
+
+        void startSkipping()
+        {
+            m_w = std::exp(std::log(openUnit()) / static_cast<double>(m_k));
+            nextSkip();
+        }
+
+        void nextSkip()
+        {
+            const double skip{ std::floor(std::log(openUnit()) / std::log1p(-m_w)) };
+            m_skip = skip < static_cast<double>(std::numeric_limits<std::uint64_t>::max())
+                ? static_cast<std::uint64_t>(skip)
+                : std::numeric_limits<std::uint64_t>::max();
+        }
+    };
+
+    // Shuffles data using every core, reproducibly for a given seed (whatever the number of threads).
+    // Sanders' algorithm ("Random Permutations on Distributed, External and Hierarchical Memory", 1998):
+    //   1. cut data into blocks, and in parallel send every element to one of B buckets at random
+    //   2. shuffle every bucket on its own with Fisher-Yates, in parallel
+    // Because each element picks its bucket independently and each bucket is then fully shuffled,
+    // every permutation is equally likely. It needs a second array the size of data to scatter into.
+    template <typename T>
+    void parallelShuffle(std::span<T> data, std::uint64_t seed, unsigned int threads = Parallel::defaultThreads())
+    {
+        constexpr std::size_t blockSize{ 1 << 16 };
+        constexpr std::size_t bucketTarget{ 1 << 18 }; // small enough that a bucket's Fisher-Yates stays mostly in cache
+
+        const std::size_t n{ data.size() };
+        const std::size_t blocks{ (n + blockSize - 1) / blockSize };
+        const auto buckets{ static_cast<std::uint32_t>(std::clamp<std::size_t>(n / bucketTarget, 1, 1024)) };
+
+        const auto blockEngine = [seed](std::uint64_t block) { return seeded<Xoshiro256x4>(seed, block); };
+
+        // Walks block number block, calling visit(index, bucket) for each element.
+        // The bucket choices come from the block's own stream, so replaying them twice gives the same answer.
+        const auto forEachInBlock = [&](std::size_t block, auto visit) {
+            Xoshiro256x4 engine{ blockEngine(block) };
+            detail::BulkWords words{ engine };
+            const std::size_t end{ std::min(n, (block + 1) * blockSize) };
+            for (std::size_t i{ block * blockSize }; i < end; ++i)
+                visit(i, detail::bounded32(words, buckets));
+        };
+
+        // pass 1: count how many elements each block sends to each bucket
+        std::vector<std::size_t> counts(blocks * buckets);
+        Parallel::forEachChunk(blocks, threads, [&](std::uint64_t block, unsigned int) {
+            std::size_t* mine{ counts.data() + block * buckets };
+            forEachInBlock(block, [mine](std::size_t, std::uint32_t bucket) { ++mine[bucket]; });
+        });
+
+        // turn the counts into where each block writes in each bucket (buckets laid out one after another)
+        std::vector<std::size_t> bucketStart(buckets + 1);
+        std::size_t offset{ 0 };
+        for (std::uint32_t bucket{ 0 }; bucket < buckets; ++bucket)
+        {
+            bucketStart[bucket] = offset;
+            for (std::size_t block{ 0 }; block < blocks; ++block)
+            {
+                const std::size_t count{ counts[block * buckets + bucket] };
+                counts[block * buckets + bucket] = offset;
+                offset += count;
+            }
+        }
+        bucketStart[buckets] = n;
+
+        // pass 2: scatter, replaying the same bucket choices
+        std::vector<T> scattered(n);
+        Parallel::forEachChunk(blocks, threads, [&](std::uint64_t block, unsigned int) {
+            std::size_t* cursor{ counts.data() + block * buckets };
+            forEachInBlock(block, [&](std::size_t i, std::uint32_t bucket) { scattered[cursor[bucket]++] = std::move(data[i]); });
+        });
+
+        // pass 3: Fisher-Yates inside each bucket, then move the bucket back into place
+        Parallel::forEachChunk(buckets, threads, [&](std::uint64_t bucket, unsigned int) {
+            Xoshiro256x4 engine{ blockEngine(blocks + bucket) }; // streams after the block streams
+            detail::BulkWords words{ engine };
+
+            const std::size_t begin{ bucketStart[bucket] };
+            const std::size_t end{ bucketStart[bucket + 1] };
+            for (std::size_t i{ end - begin }; i > 1; --i)
+            {
+                const std::size_t j{ detail::boundedOffset(words, i - 1) };
+                std::swap(scattered[begin + i - 1], scattered[begin + j]);
+            }
+
+            std::move(scattered.begin() + static_cast<std::ptrdiff_t>(begin), scattered.begin() + static_cast<std::ptrdiff_t>(end),
+                      data.begin() + static_cast<std::ptrdiff_t>(begin));
+        });
+    }
+}
+
+#endif
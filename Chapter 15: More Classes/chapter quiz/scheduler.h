@@ -0,0 +1,214 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A work-stealing scheduler for running the same job over a whole population every game tick.
+// Parallel::forEachChunk starts new threads on every call and hands out equal-sized chunks, which is fine for
+// uniform work, but per-monster AI cost varies a lot (a dragon thinks much harder than a zombie), so a thread that
+// draws a dragon-heavy part of the population finishes long after the others.
+// TickScheduler keeps its threads alive between ticks, and every tick:
+//   1. gives each thread one contiguous share of [0, count) in its own deque
+//   2. each thread repeatedly takes the newest range from the back of its own deque, and while that range is bigger
+//      than grain, splits it in half and pushes the upper half back, then runs the job on what's left
+//   3. a thread whose deque is empty steals the oldest (so largest) range from the front of another thread's deque
+// so idle threads take over half of a busy thread's remaining work at a time, until everything is done.
+// Mode::staticPartition turns step 3 off, for comparison.
+// Sample call:
+//     TickScheduler scheduler{};
+//     scheduler.run(monsters.size(), [&](std::size_t begin, std::size_t end) { think(monsters, begin, end); });
+class TickScheduler
+{
+public:
+    enum class Mode
+    {
+        workStealing,
+        staticPartition, // each thread only ever works on its own share
+    };
+
+    explicit TickScheduler(unsigned int threads = Parallel::defaultThreads())
+    {
+        threads = std::max(1u, threads);
+        for (unsigned int t{ 0 }; t < threads; ++t)
+            m_workers.push_back(std::make_unique<Worker>());
+        for (unsigned int t{ 1 }; t < threads; ++t) // the thread calling run() is worker 0
+            m_threads.emplace_back([this, t] { workerLoop(t); });
+    }
+
+    ~TickScheduler()
+    {
+        {
+            std::lock_guard lock{ m_mutex };
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    unsigned int threads() const { return static_cast<unsigned int>(m_workers.size()); }
+
+    // Calls work(begin, end) on disjoint ranges covering [0, count), no range longer than grain, and returns when all are done
+    void run(std::size_t count, std::function<void(std::size_t, std::size_t)> work, std::size_t grain = 256,
+             Mode mode = Mode::workStealing)
+    {
+        if (count == 0)
+            return;
+
+        const std::size_t shares{ m_workers.size() };
+        for (std::size_t t{ 0 }; t < shares; ++t)
+        {
+            const std::size_t begin{ count * t / shares };
+            const std::size_t end{ count * (t + 1) / shares };
+            if (begin < end)
+                m_workers[t]->ranges.push_back(Range{ begin, end });
+        }
+
+        m_work = std::move(work);
+        m_grain = std::max<std::size_t>(1, grain);
+        m_mode = mode;
+        m_remaining = count;
+
+        {
+            std::lock_guard lock{ m_mutex };
+            m_running = static_cast<unsigned int>(m_threads.size());
+            ++m_generation;
+        }
+        m_start.notify_all();
+
+        process(0);
+
+        // wait for the other threads to be completely finished with this tick before its state is reused
+        std::unique_lock lock{ m_mutex };
+        m_done.wait(lock, [this] { return m_running == 0; });
+    }
+
+private:
+    struct Range
+    {
+        std::size_t begin{};
+        std::size_t end{};
+    };
+
+    // Each deque has its own lock, so threads only contend when one is stealing from another
+    struct alignas(64) Worker
+    {
+        std::mutex mutex{};
+        std::deque<Range> ranges{};
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers{};
+    std::vector<std::thread> m_threads{};
+
+    std::mutex m_mutex{};
+    std::condition_variable m_start{};
+    std::condition_variable m_done{};
+    std::uint64_t m_generation{ 0 };
+    unsigned int m_running{ 0 };
+    bool m_stop{ false };
+
+    // the current tick
+    std::function<void(std::size_t, std::size_t)> m_work{};
+    std::size_t m_grain{};
+    Mode m_mode{};
+    std::atomic<std::size_t> m_remaining{ 0 };
+
+    void workerLoop(unsigned int index)
+    {
+        std::uint64_t seen{ 0 };
+        for (;;)
+        {
+            {
+                std::unique_lock lock{ m_mutex };
+                m_start.wait(lock, [&] { return m_stop || m_generation != seen; });
+                if (m_stop)
+                    return;
+                seen = m_generation;
+            }
+
+            process(index);
+
+            std::lock_guard lock{ m_mutex };
+            if (--m_running == 0)
+                m_done.notify_one();
+        }
+    }
+
+    bool popOwn(unsigned int index, Range& range)
+    {
+        Worker& worker{ *m_workers[index] };
+        std::lock_guard lock{ worker.mutex };
+        if (worker.ranges.empty())
+            return false;
+        range = worker.ranges.back();
+        worker.ranges.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned int index, Range& range)
+    {
+        const auto count{ static_cast<unsigned int>(m_workers.size()) };
+        for (unsigned int offset{ 1 }; offset < count; ++offset)
+        {
+            Worker& victim{ *m_workers[(index + offset) % count] };
+            std::lock_guard lock{ victim.mutex };
+            if (!victim.ranges.empty())
+            {
+                range = victim.ranges.front();
+                victim.ranges.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void process(unsigned int index)
+    {
+        while (m_remaining.load(std::memory_order_acquire) > 0)
+        {
+            Range range{};
+            if (!popOwn(index, range))
+            {
+                if (m_mode == Mode::staticPartition)
+                    return;
+                if (!steal(index, range))
+                {
+                    std::this_thread::yield(); // the last ranges are being worked on elsewhere
+                    continue;
+                }
+            }
+
+            // keep the lower half, and leave the upper half where it can be stolen
+            while (range.end - range.begin > m_grain)
+            {
+                const std::size_t middle{ range.begin + (range.end - range.begin) / 2 };
+                {
+                    Worker& worker{ *m_workers[index] };
+                    std::lock_guard lock{ worker.mutex };
+                    worker.ranges.push_back(Range{ middle, range.end });
+                }
+                range.end = middle;
+            }
+
+            m_work(range.begin, range.end);
+            m_remaining.fetch_sub(range.end - range.begin, std::memory_order_release);
+        }
+    }
+};
+
+#endif
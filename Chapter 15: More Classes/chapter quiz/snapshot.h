@@ -0,0 +1,269 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "monster.h"
+#include "monsterpool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Binary snapshots of monster populations.
+// A snapshot file is laid out exactly as the program uses it in memory, so loading one is just mapping the file
+// (mmap, so this part is POSIX only): no parsing, no copies, and pages are only read from disk when first touched.
+//
+// File layout (native byte order, every section starting on an 8-byte boundary):
+//     Header
+//     StringEntry[header.stringCount]      where each string's bytes are in the string data
+//     char[header.stringBytes]             the string data (names and roars, each stored once)
+//     Record[header.monsterCount]          one fixed-size record per monster
+//
+// Bump Snapshot::version whenever the layout changes, so old files are rejected instead of misread.
+namespace Snapshot
+{
+    constexpr char magic[8]{ 'M', 'O', 'N', 'S', 'T', 'E', 'R', 'S' };
+    constexpr std::uint32_t version{ 1 };
+
+    struct Header
+    {
+        char magic[8]{};
+        std::uint32_t version{}; // a file written with the other byte order reads as a different version
+        std::uint32_t stringCount{};
+        std::uint64_t stringBytes{};
+        std::uint64_t monsterCount{};
+        std::uint64_t stringsOffset{};
+        std::uint64_t stringDataOffset{};
+        std::uint64_t recordsOffset{};
+    };
+
+    struct StringEntry
+    {
+        std::uint32_t offset{}; // into the string data
+        std::uint32_t length{};
+    };
+
+    struct Record
+    {
+        std::uint32_t name{}; // index into the string table
+        std::uint32_t roar{};
+        std::int32_t hitpoints{};
+        std::uint8_t type{};
+        std::uint8_t padding[3]{};
+    };
+
+    static_assert(sizeof(Header) == 56 && sizeof(StringEntry) == 8 && sizeof(Record) == 16,
+                  "the file layout must not depend on the compiler");
+
+    namespace detail
+    {
+        constexpr std::uint64_t align8(std::uint64_t offset) { return (offset + 7) & ~std::uint64_t{ 7 }; }
+
+        // Builds a snapshot file in memory from count monsters, where monster(i) returns {type, name, roar, hitpoints}
+        // and names and roars are StringTable ids of Monster::strings()
+        template <typename Get>
+        std::vector<char> build(std::size_t count, Get monster)
+        {
+            // each distinct Monster::strings() id gets the next snapshot string index, in order of first use
+            constexpr std::uint32_t unused{ 0xFFFFFFFF };
+            std::vector<std::uint32_t> remap{};
+            std::vector<StringEntry> strings{};
+            std::string stringData{};
+            const auto index = [&](StringTable::Id id) {
+                if (id >= remap.size())
+                    remap.resize(id + 1, unused);
+                if (remap[id] == unused)
+                {
+                    const std::string_view text{ Monster::strings().view(id) };
+                    remap[id] = static_cast<std::uint32_t>(strings.size());
+                    strings.push_back({ static_cast<std::uint32_t>(stringData.size()), static_cast<std::uint32_t>(text.size()) });
+                    stringData += text;
+                }
+                return remap[id];
+            };
+
+            std::vector<Record> records(count);
+            for (std::size_t i{ 0 }; i < count; ++i)
+            {
+                const auto [type, name, roar, hitpoints]{ monster(i) };
+                records[i] = Record{ index(name), index(roar), hitpoints, static_cast<std::uint8_t>(type), {} };
+            }
+
+            Header header{};
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.version = version;
+            header.stringCount = static_cast<std::uint32_t>(strings.size());
+            header.stringBytes = stringData.size();
+            header.monsterCount = count;
+            header.stringsOffset = align8(sizeof(Header));
+            header.stringDataOffset = align8(header.stringsOffset + strings.size() * sizeof(StringEntry));
+            header.recordsOffset = align8(header.stringDataOffset + stringData.size());
+
+            std::vector<char> file(header.recordsOffset + records.size() * sizeof(Record));
+            std::memcpy(file.data(), &header, sizeof(header));
+            std::memcpy(file.data() + header.stringsOffset, strings.data(), strings.size() * sizeof(StringEntry));
+            std::memcpy(file.data() + header.stringDataOffset, stringData.data(), stringData.size());
+            std::memcpy(file.data() + header.recordsOffset, records.data(), records.size() * sizeof(Record));
+            return file;
+        }
+
+        inline bool writeFile(const std::string& path, const std::vector<char>& contents)
+        {
+            std::ofstream out{ path, std::ios::binary | std::ios::trunc };
+            out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+            return static_cast<bool>(out);
+        }
+    }
+
+    // Writes monsters to a snapshot file at path. Returns false if the file couldn't be written.
+    inline bool save(const std::string& path, std::span<const Monster> monsters)
+    {
+        return detail::writeFile(path, detail::build(monsters.size(), [monsters](std::size_t i) {
+            const Monster& monster{ monsters[i] };
+            return std::tuple{ monster.getType(), monster.getNameId(), monster.getRoarId(), monster.getHitpoints() };
+        }));
+    }
+
+    inline bool save(const std::string& path, const MonsterPool& pool)
+    {
+        return detail::writeFile(path, detail::build(pool.size(), [&pool](std::size_t i) {
+            return std::tuple{ pool.type(i), MonsterGenerator::nameId(pool.names()[i]),
+                               MonsterGenerator::roarId(pool.roars()[i]), pool.hitpoints()[i] };
+        }));
+    }
+
+    // A read-only view of a snapshot file mapped into memory.
+    // Everything it hands out (records, string_views) points into the mapping, so it's only valid while the View lives.
+    // Sample call:
+    //     if (std::optional<Snapshot::View> world{ Snapshot::View::open("world.monsters") })
+    //         world->toMonster(0).print();
+    class View
+    {
+    public:
+        // Maps the snapshot at path. Returns std::nullopt if the file can't be opened or isn't a valid snapshot of this version.
+        static std::optional<View> open(const std::string& path)
+        {
+            const int fd{ ::open(path.c_str(), O_RDONLY) };
+            if (fd < 0)
+                return std::nullopt;
+
+            struct stat info{};
+            const bool statted{ ::fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(Header)) };
+            void* mapped{ statted ? ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED };
+            ::close(fd); // the mapping keeps the file alive
+            if (mapped == MAP_FAILED)
+                return std::nullopt;
+
+            View view{ static_cast<const char*>(mapped), static_cast<std::size_t>(info.st_size) };
+            if (!view.valid())
+                return std::nullopt;
+            return view;
+        }
+
+        View(View&& other) noexcept
+            : m_data{ std::exchange(other.m_data, nullptr) }, m_size{ std::exchange(other.m_size, 0) }
+        {
+        }
+
+        View& operator=(View&& other) noexcept
+        {
+            std::swap(m_data, other.m_data);
+            std::swap(m_size, other.m_size);
+            return *this;
+        }
+
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+
+        ~View()
+        {
+            if (m_data)
+                ::munmap(const_cast<char*>(m_data), m_size);
+        }
+
+        std::size_t size() const { return static_cast<std::size_t>(header().monsterCount); }
+
+        std::span<const Record> records() const
+        {
+            return { reinterpret_cast<const Record*>(m_data + header().recordsOffset), size() };
+        }
+
+        std::string_view string(std::uint32_t index) const
+        {
+            const StringEntry& entry{ strings()[index] };
+            return { m_data + header().stringDataOffset + entry.offset, entry.length };
+        }
+
+        Monster::Type type(std::size_t index) const { return static_cast<Monster::Type>(records()[index].type); }
+        std::string_view name(std::size_t index) const { return string(records()[index].name); }
+        std::string_view roar(std::size_t index) const { return string(records()[index].roar); }
+        int hitpoints(std::size_t index) const { return records()[index].hitpoints; }
+
+        // Builds a regular Monster for monster number index (interning its name and roar)
+        Monster toMonster(std::size_t index) const
+        {
+            return Monster{ type(index), name(index), roar(index), hitpoints(index) };
+        }
+
+        // Checks that every record's type and string indices are in range.
+        // This reads the whole file, so only call it for snapshots you didn't write yourself.
+        bool checkRecords() const
+        {
+            const std::uint32_t stringCount{ header().stringCount };
+            for (const Record& record : records())
+                if (record.name >= stringCount || record.roar >= stringCount || record.type >= Monster::maxMonsterTypes)
+                    return false;
+            return true;
+        }
+
+    private:
+        const char* m_data{};
+        std::size_t m_size{};
+
+        View(const char* data, std::size_t size) : m_data{ data }, m_size{ size } {}
+
+        const Header& header() const { return *reinterpret_cast<const Header*>(m_data); }
+
+        std::span<const StringEntry> strings() const
+        {
+            return { reinterpret_cast<const StringEntry*>(m_data + header().stringsOffset), header().stringCount };
+        }
+
+        // Checks the header, and that every section, string and record lies inside the file
+        bool valid() const
+        {
+            const Header& h{ header() };
+            if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.version != version)
+                return false;
+
+            const auto fits = [this](std::uint64_t offset, std::uint64_t count, std::uint64_t size) {
+                return offset % 8 == 0 && offset <= m_size && count <= (m_size - offset) / size;
+            };
+            if (!fits(h.stringsOffset, h.stringCount, sizeof(StringEntry)) || !fits(h.stringDataOffset, h.stringBytes, 1)
+                || !fits(h.recordsOffset, h.monsterCount, sizeof(Record)))
+                return false;
+
+            for (const StringEntry& entry : strings())
+                if (entry.offset > h.stringBytes || entry.length > h.stringBytes - entry.offset)
+                    return false;
+
+            // checking every record would mean reading the whole file, which is what mapping it avoids,
+            // so that's left to checkRecords()
+            return true;
+        }
+    };
+}
+
+#endif
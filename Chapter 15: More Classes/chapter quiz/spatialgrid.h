@@ -0,0 +1,255 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "../../Chapter 14: Intro to Classes/point2d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// A uniform-grid spatial index for positioned entities (monsters, players, ...).
+// Finding everything near a point by calling Point2d::distanceTo on every entity costs O(n) work and a sqrt per entity.
+// SpatialGrid cuts the world into square cells and keeps, for each cell, the entities currently inside it, so a query
+// only looks at the few cells that overlap the search area, and compares squared distances (no sqrt).
+// Moving an entity is O(1): if it stays in its cell only its position changes, otherwise it's swapped out of the old
+// cell's list and appended to the new one.
+//
+// Entities are identified by small integer ids chosen by the caller (e.g. their index in a MonsterPool).
+// The world covers [0, width) x [0, height); positions outside it are kept in the nearest edge cell.
+// Sample call:
+//     SpatialGrid grid{ 10000.0, 10000.0, 50.0 };
+//     grid.insert(0, Point2d{ 12.0, 34.0 });
+//     std::vector<SpatialGrid::Id> nearby{ grid.withinRadius(Point2d{ 10.0, 30.0 }, 25.0) };
+class SpatialGrid
+{
+public:
+    using Id = std::uint32_t;
+
+    // An entity found by a query, with its squared distance from the query point
+    struct Hit
+    {
+        Id id{};
+        double distanceSquared{};
+    };
+
+    SpatialGrid(double width, double height, double cellSize)
+        : m_cellSize{ cellSize }
+        , m_columns{ std::max(1, static_cast<int>(std::ceil(width / cellSize))) }
+        , m_rows{ std::max(1, static_cast<int>(std::ceil(height / cellSize))) }
+        , m_cells(static_cast<std::size_t>(m_columns) * static_cast<std::size_t>(m_rows))
+    {
+    }
+
+    std::size_t size() const { return m_size; }
+    bool contains(Id id) const { return id < m_entities.size() && m_entities[id].cell != none; }
+
+    Point2d position(Id id) const
+    {
+        const Entry& entry{ entryOf(id) };
+        return Point2d{ entry.x, entry.y };
+    }
+
+    // Adds entity id at position (id must not be in the grid already)
+    void insert(Id id, Point2d position)
+    {
+        if (id >= m_entities.size())
+            m_entities.resize(id + 1);
+        add(id, position, cellOf(position));
+        ++m_size;
+    }
+
+    // Moves entity id to position
+    void move(Id id, Point2d position)
+    {
+        Location& location{ m_entities[id] };
+        const std::uint32_t cell{ cellOf(position) };
+        if (cell == location.cell)
+        {
+            Entry& entry{ m_cells[cell][location.slot] };
+            entry.x = position.getX();
+            entry.y = position.getY();
+            return;
+        }
+
+        detach(id);
+        add(id, position, cell);
+    }
+
+    void remove(Id id)
+    {
+        detach(id);
+        m_entities[id] = Location{};
+        --m_size;
+    }
+
+    // Calls fn(id, distanceSquared) for every entity within radius of center (inclusive), in no particular order
+    template <typename Function>
+    void forEachWithinRadius(Point2d center, double radius, Function fn) const
+    {
+        const double radiusSquared{ radius * radius };
+        const int firstColumn{ columnOf(center.getX() - radius) };
+        const int lastColumn{ columnOf(center.getX() + radius) };
+        const int firstRow{ rowOf(center.getY() - radius) };
+        const int lastRow{ rowOf(center.getY() + radius) };
+
+        for (int row{ firstRow }; row <= lastRow; ++row)
+            for (int column{ firstColumn }; column <= lastColumn; ++column)
+                for (const Entry& entry : m_cells[indexOf(column, row)])
+                {
+                    const double d2{ distanceSquared(entry, center) };
+                    if (d2 <= radiusSquared)
+                        fn(entry.id, d2);
+                }
+    }
+
+    // Returns the ids of every entity within radius of center, in no particular order
+    std::vector<Id> withinRadius(Point2d center, double radius) const
+    {
+        std::vector<Id> found{};
+        forEachWithinRadius(center, radius, [&found](Id id, double) { found.push_back(id); });
+        return found;
+    }
+
+    // Returns the k entities closest to center, closest first (fewer if the grid holds fewer than k).
+    // Searches outward one ring of cells at a time, and stops once no unsearched cell can hold anything
+    // closer than the k-th best so far.
+    std::vector<Hit> nearest(Point2d center, std::size_t k) const
+    {
+        const auto farther = [](const Hit& a, const Hit& b) { return a.distanceSquared < b.distanceSquared; };
+        std::priority_queue<Hit, std::vector<Hit>, decltype(farther)> best{ farther }; // the worst of the best k on top
+        if (k == 0)
+            return {};
+
+        const int centerColumn{ columnOf(center.getX()) };
+        const int centerRow{ rowOf(center.getY()) };
+
+        // how far center is from the nearest edge of its own cell (0 if it's outside the world)
+        const double offsetX{ center.getX() - centerColumn * m_cellSize };
+        const double offsetY{ center.getY() - centerRow * m_cellSize };
+        const double edge{ std::max(0.0, std::min({ offsetX, m_cellSize - offsetX, offsetY, m_cellSize - offsetY })) };
+
+        const int maxRing{ std::max({ centerColumn, m_columns - 1 - centerColumn, centerRow, m_rows - 1 - centerRow }) };
+        for (int ring{ 0 }; ring <= maxRing; ++ring)
+        {
+            // everything in this ring is at least this far away, so if the k-th best is closer, we're done
+            if (ring > 0 && best.size() == k)
+            {
+                const double bound{ (ring - 1) * m_cellSize + edge };
+                if (bound * bound > best.top().distanceSquared)
+                    break;
+            }
+
+            forEachCellInRing(centerColumn, centerRow, ring, [&](const std::vector<Entry>& cell) {
+                for (const Entry& entry : cell)
+                {
+                    const double d2{ distanceSquared(entry, center) };
+                    if (best.size() < k)
+                        best.push(Hit{ entry.id, d2 });
+                    else if (d2 < best.top().distanceSquared)
+                    {
+                        best.pop();
+                        best.push(Hit{ entry.id, d2 });
+                    }
+                }
+            });
+        }
+
+        std::vector<Hit> result(best.size());
+        for (std::size_t i{ result.size() }; i > 0; --i)
+        {
+            result[i - 1] = best.top();
+            best.pop();
+        }
+        return result;
+    }
+
+private:
+    static constexpr std::uint32_t none{ 0xFFFFFFFF };
+
+    struct Entry
+    {
+        double x{};
+        double y{};
+        Id id{};
+    };
+
+    // Where an entity's entry is: m_cells[cell][slot]
+    struct Location
+    {
+        std::uint32_t cell{ none };
+        std::uint32_t slot{ none };
+    };
+
+    double m_cellSize{};
+    int m_columns{};
+    int m_rows{};
+    std::vector<std::vector<Entry>> m_cells{};
+    std::vector<Location> m_entities{}; // indexed by id
+    std::size_t m_size{ 0 };
+
+    static double distanceSquared(const Entry& entry, Point2d point)
+    {
+        return Point2d{ entry.x, entry.y }.distanceSquaredTo(point);
+    }
+
+    int columnOf(double x) const { return std::clamp(static_cast<int>(std::floor(x / m_cellSize)), 0, m_columns - 1); }
+    int rowOf(double y) const { return std::clamp(static_cast<int>(std::floor(y / m_cellSize)), 0, m_rows - 1); }
+    std::uint32_t indexOf(int column, int row) const { return static_cast<std::uint32_t>(row * m_columns + column); }
+    std::uint32_t cellOf(Point2d p) const { return indexOf(columnOf(p.getX()), rowOf(p.getY())); }
+
+    const Entry& entryOf(Id id) const
+    {
+        const Location& location{ m_entities[id] };
+        return m_cells[location.cell][location.slot];
+    }
+
+    void add(Id id, Point2d position, std::uint32_t cell)
+    {
+        std::vector<Entry>& entries{ m_cells[cell] };
+        m_entities[id] = Location{ cell, static_cast<std::uint32_t>(entries.size()) };
+        entries.push_back(Entry{ position.getX(), position.getY(), id });
+    }
+
+    // Takes id out of its cell's list by moving the cell's last entry into its slot
+    void detach(Id id)
+    {
+        const Location location{ m_entities[id] };
+        std::vector<Entry>& entries{ m_cells[location.cell] };
+        entries[location.slot] = entries.back();
+        m_entities[entries[location.slot].id].slot = location.slot;
+        entries.pop_back();
+    }
+
+    // Calls visit(cell) for each cell of the grid at exactly ring cells (in columns or rows) from (column, row)
+    template <typename Visit>
+    void forEachCellInRing(int column, int row, int ring, Visit visit) const
+    {
+        if (ring == 0)
+        {
+            visit(m_cells[indexOf(column, row)]);
+            return;
+        }
+
+        const int left{ column - ring };
+        const int right{ column + ring };
+        const int top{ row - ring };
+        const int bottom{ row + ring };
+
+        // the top and bottom rows of the ring, then the columns in between
+        for (int r : { top, bottom })
+            if (r >= 0 && r < m_rows)
+                for (int c{ std::max(left, 0) }; c <= std::min(right, m_columns - 1); ++c)
+                    visit(m_cells[indexOf(c, r)]);
+
+        for (int c : { left, right })
+            if (c >= 0 && c < m_columns)
+                for (int r{ std::max(top + 1, 0) }; r <= std::min(bottom - 1, m_rows - 1); ++r)
+                    visit(m_cells[indexOf(c, r)]);
+    }
+};
+
+#endif
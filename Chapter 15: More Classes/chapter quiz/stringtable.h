@@ -0,0 +1,108 @@
+#ifndef STRINGTABLE_H
+#define STRINGTABLE_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// An interning string table: every distinct string is stored once, and objects hold a small integer id instead
+// of their own std::string. Copying an id never allocates, and comparing two ids compares the strings.
+// Only intern() can allocate (the first time it sees a string) or lock; lookups by id never do either.
+// Sample call:
+//     StringTable table{};
+//     StringTable::Id id{ table.intern("Goofy") };
+//     std::cout << table.view(id);
+class StringTable
+{
+public:
+    using Id = std::uint32_t;
+
+    StringTable() = default;
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    ~StringTable()
+    {
+        for (auto& chunk : m_chunks)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    // Returns the id of text, adding it to the table if it isn't there yet
+    Id intern(std::string_view text)
+    {
+        std::lock_guard lock{ m_mutex };
+
+        if (auto found{ m_ids.find(text) }; found != m_ids.end())
+            return found->second;
+
+        // std::deque never moves its elements when it grows, so the string_view keys (and views) stay valid
+        const std::string& stored{ m_strings.emplace_back(text) };
+        const auto id{ static_cast<Id>(m_strings.size() - 1) };
+        m_ids.emplace(stored, id);
+
+        // only intern() writes to the chunks, and always under the lock, so a relaxed load is enough here
+        const auto [chunk, offset]{ locate(id) };
+        std::string_view* views{ m_chunks[chunk].load(std::memory_order_relaxed) };
+        if (!views)
+        {
+            views = new std::string_view[chunkCapacity(chunk)];
+            m_chunks[chunk].store(views, std::memory_order_release);
+        }
+        views[offset] = stored;
+        m_size.store(m_strings.size(), std::memory_order_release);
+        return id;
+    }
+
+    // Returns the string with the given id (which must have come from intern()).
+    // Never locks: the view for an id is written once, before intern() returns the id, and never moves, so any
+    // thread that was handed the id can read it while other threads keep interning.
+    std::string_view view(Id id) const
+    {
+        const auto [chunk, offset]{ locate(id) };
+        return m_chunks[chunk].load(std::memory_order_acquire)[offset];
+    }
+
+    std::size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+private:
+    // The views live in chunks that double in size (256, 256, 512, 1024, ... entries), so a chunk never has to be
+    // copied to grow the table, and 25 chunks cover every 32-bit id
+    static constexpr unsigned int firstChunkBits{ 8 };
+    static constexpr std::size_t chunkCount{ 33 - firstChunkBits };
+
+    struct Location
+    {
+        std::size_t chunk{};
+        std::size_t offset{};
+    };
+
+    static constexpr std::size_t chunkCapacity(std::size_t chunk)
+    {
+        return std::size_t{ 1 } << (chunk == 0 ? firstChunkBits : firstChunkBits + chunk - 1);
+    }
+
+    static constexpr Location locate(Id id)
+    {
+        // chunk c >= 1 starts at id 2^(firstChunkBits + c - 1)
+        const auto bits{ static_cast<std::size_t>(std::bit_width(id)) };
+        if (bits <= firstChunkBits)
+            return { 0, id };
+        const std::size_t chunk{ bits - firstChunkBits };
+        return { chunk, id - (std::size_t{ 1 } << (bits - 1)) };
+    }
+
+    std::mutex m_mutex{}; // taken by intern() only
+    std::deque<std::string> m_strings{};
+    std::unordered_map<std::string_view, Id> m_ids{};
+    std::array<std::atomic<std::string_view*>, chunkCount> m_chunks{};
+    std::atomic<std::size_t> m_size{ 0 };
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+dice.h Checks
+    Dice::parse on well-formed expressions, malformed ones, and ones whose totals don't fit in an int.
+    Prints one line per check and returns 1 if any failed.
+
+    Build: g++ -std=c++20 -O2 -pthread dice.cpp
+    Usage: ./a.out
+*/
+
+#include "../dice.h"
+
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+bool check(bool passed, std::string_view what)
+{
+    std::cout << (passed ? "passed  " : "FAILED  ") << what << '\n';
+    return passed;
+}
+
+bool parsesTo(std::string_view text, int count, int sides, int modifier)
+{
+    const std::optional<Dice::Expression> expression{ Dice::parse(text) };
+    return check(expression && expression->count == count && expression->sides == sides && expression->modifier == modifier, text);
+}
+
+bool rejects(std::string_view text)
+{
+    return check(!Dice::parse(text), std::string{ "rejects " } + std::string{ text });
+}
+
+int main()
+{
+    bool ok{ true };
+    ok = parsesTo("3d6", 3, 6, 0) && ok;
+    ok = parsesTo("d20", 1, 20, 0) && ok;
+    ok = parsesTo("2d8+1", 2, 8, 1) && ok;
+    ok = parsesTo("4d4-3", 4, 4, -3) && ok;
+    ok = parsesTo("1d2147483647", 1, 2147483647, 0) && ok; // the largest total that fits
+    ok = parsesTo("2d6-2147483647", 2, 6, -2147483647) && ok;
+    ok = parsesTo("2d6-2147483648", 2, 6, -2147483647 - 1) && ok; // the smallest int as a modifier
+
+    ok = rejects("") && ok;
+    ok = rejects("3x6") && ok;
+    ok = rejects("0d6") && ok;
+    ok = rejects("3d6+") && ok;
+    ok = rejects("100000d100000") && ok;  // count * sides overflows an int
+    ok = rejects("2d2147483647") && ok;
+    ok = rejects("1d6+2147483647") && ok; // the modifier pushes the largest total over
+    ok = rejects("3d6--5") && ok;         // one sign per modifier
+    ok = rejects("3d6+-5") && ok;
+    ok = rejects("1d6--2147483648") && ok;
+
+    // still parses, but has too many totals for a histogram
+    const std::optional<Dice::Expression> wide{ Dice::parse("1000d100000") };
+    ok = check(wide && Dice::histogram(*wide, 10, 1).empty(), "histogram of 1000d100000 is empty rather than huge") && ok;
+
+    // the widest histogram allowed runs with one set of counters, however many threads are asked for
+    const std::vector<std::uint64_t> widest{ Dice::histogram(*Dice::parse("1d8000000"), 1000, 1, 4) };
+    ok = check(widest.size() == 8'000'000 && std::accumulate(widest.begin(), widest.end(), std::uint64_t{ 0 }) == 1000,
+               "histogram of 1d8000000 counts every roll") && ok;
+
+    const Dice::Expression threeD6{ *Dice::parse("3d6") };
+    ok = check(Dice::histogram(threeD6, 1'000'000, 7, 1) == Dice::histogram(threeD6, 1'000'000, 7, 4),
+               "histogram of 3d6 is the same on 1 and 4 threads") && ok;
+
+    return ok ? 0 : 1;
+}
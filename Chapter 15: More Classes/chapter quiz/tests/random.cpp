@@ -0,0 +1,127 @@
+/*
+random.h Checks
+    Small self-checking calls for behavior of random.h that is easy to break without noticing.
+    Prints one line per check and returns 1 if any failed.
+
+    Build: g++ -std=c++20 -O2 random.cpp
+    Usage: ./a.out        (runs itself again, with and without RANDOM_SEED, to check that a logged seed replays)
+*/
+
+#include "../random.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+bool check(bool passed, const char* what)
+{
+    std::cout << (passed ? "passed  " : "FAILED  ") << what << '\n';
+    return passed;
+}
+
+// A checksum of what Random::get and Random::fill draw first
+std::uint64_t draw()
+{
+    std::uint64_t sum{ 0 };
+    for (int i{ 0 }; i < 100; ++i)
+        sum = sum * 31 + static_cast<std::uint64_t>(Random::get(1, 1'000'000));
+
+    std::vector<int> values(1000);
+    Random::fill(std::span{ values }, 1, 1'000'000);
+    for (int value : values)
+        sum = sum * 31 + static_cast<std::uint64_t>(value);
+    return sum;
+}
+
+// Runs command (POSIX popen) and returns the numbers it prints
+std::vector<std::uint64_t> runChild(const std::string& command)
+{
+    std::vector<std::uint64_t> numbers{};
+    if (FILE* child{ popen(command.c_str(), "r") })
+    {
+        for (std::uint64_t number{}; std::fscanf(child, "%" SCNu64, &number) == 1;)
+            numbers.push_back(number);
+        pclose(child);
+    }
+    return numbers;
+}
+
+// A logged seed must replay the run: reseed(s) as the very first call, reseed(s) again, and a fresh run of this
+// program with RANDOM_SEED=s must all draw the same numbers.
+// This has to run before anything else touches Random, since the engines are seeded on first use.
+bool seedsReplay(const char* program)
+{
+    Random::reseed(42);
+    const std::uint64_t first{ draw() };
+    Random::reseed(42);
+    const std::uint64_t second{ draw() };
+
+    // run this program again as "RANDOM_SEED=42 ./a.out draw", which prints draw() from a fresh process
+    const std::vector<std::uint64_t> fromEnvironment{ runChild("RANDOM_SEED=42 '" + std::string{ program } + "' draw") };
+
+    Random::reseed(43);
+    const std::uint64_t other{ draw() };
+
+    return check(first == second && fromEnvironment == std::vector{ first } && other != first,
+                 "reseed(42) twice and RANDOM_SEED=42 draw the same numbers");
+}
+
+// A run without RANDOM_SEED draws a random process seed, and logging it must be enough to replay that run
+bool loggedSeedReplays(const char* program)
+{
+    // "./a.out logged" prints Random::processSeed() and then draw()
+    const std::vector<std::uint64_t> logged{ runChild("env -u RANDOM_SEED '" + std::string{ program } + "' logged") };
+    const std::vector<std::uint64_t> replayed{ logged.size() == 2
+        ? runChild("RANDOM_SEED=" + std::to_string(logged[0]) + " '" + std::string{ program } + "' draw")
+        : std::vector<std::uint64_t>{} };
+
+    return check(logged.size() == 2 && replayed == std::vector{ logged[1] },
+                 "RANDOM_SEED=processSeed() replays a run that wasn't given a seed");
+}
+
+// Random::fill as documented, with fixed-size arrays and element types other than int
+bool fillArrays()
+{
+    std::array<int, 100> rolls{};
+    Random::fill(std::span{ rolls }, 1, 6);
+    bool ok{ std::all_of(rolls.begin(), rolls.end(), [](int roll) { return roll >= 1 && roll <= 6; }) };
+
+    short small[64]{};
+    Random::fill(std::span{ small }, 10, 20); // int bounds for short elements
+    ok = ok && std::all_of(std::begin(small), std::end(small), [](short value) { return value >= 10 && value <= 20; });
+
+    std::vector<std::uint8_t> bytes(64);
+    Random::fill(std::span{ bytes }, 0, 255);
+
+    std::array<double, 32> unit{};
+    Random::fill(std::span{ unit }, 0, 1); // int bounds for doubles
+    ok = ok && std::all_of(unit.begin(), unit.end(), [](double value) { return value >= 0.0 && value <= 1.0; });
+
+    return check(ok, "Random::fill accepts std::array, C arrays and bounds of another type");
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string{ argv[1] } == "draw") // the child run by seedsReplay() and loggedSeedReplays()
+    {
+        std::cout << draw() << '\n';
+        return 0;
+    }
+    if (argc > 1 && std::string{ argv[1] } == "logged") // the unseeded child run by loggedSeedReplays()
+    {
+        const std::uint64_t seed{ Random::processSeed() };
+        std::cout << seed << ' ' << draw() << '\n';
+        return 0;
+    }
+
+    bool ok{ seedsReplay(argv[0]) };
+    ok = loggedSeedReplays(argv[0]) && ok;
+    ok = fillArrays() && ok;
+    return ok ? 0 : 1;
+}
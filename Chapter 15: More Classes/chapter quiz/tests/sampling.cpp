@@ -0,0 +1,51 @@
+/*
+sampling.h Checks
+    Edge cases of Random::sample and Random::Reservoir: empty samples, and samples larger than the input.
+    Prints one line per check and returns 1 if any failed.
+
+    Build: g++ -std=c++20 -O2 -pthread sampling.cpp
+    Usage: ./a.out
+*/
+
+#include "../sampling.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <vector>
+
+bool check(bool passed, const char* what)
+{
+    std::cout << (passed ? "passed  " : "FAILED  ") << what << '\n';
+    return passed;
+}
+
+int main()
+{
+    bool ok{ true };
+
+    Random::Reservoir<int> none{ 0 };
+    for (int i{ 0 }; i < 10'000; ++i)
+        none.add(i);
+    ok = check(none.items().empty(), "Reservoir of size 0 stays empty") && ok;
+
+    Random::Reservoir<int> few{ 5 };
+    for (int i{ 0 }; i < 3; ++i)
+        few.add(i);
+    ok = check(few.items() == std::vector<int>{ 0, 1, 2 }, "Reservoir keeps everything when fewer than k items arrive") && ok;
+
+    Random::Reservoir<int> full{ 10 };
+    for (int i{ 0 }; i < 100'000; ++i)
+        full.add(i);
+    const std::set<int> distinct(full.items().begin(), full.items().end());
+    ok = check(full.items().size() == 10 && distinct.size() == 10 && *distinct.rbegin() < 100'000, "Reservoir keeps k distinct items") && ok;
+
+    ok = check(Random::sample(0, 100).empty(), "sample(0, n) is empty") && ok;
+
+    std::vector<std::uint64_t> all{ Random::sample(20, 10) };
+    std::sort(all.begin(), all.end());
+    ok = check(all == std::vector<std::uint64_t>{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 }, "sample(k > n, n) gives every index once") && ok;
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+#ifndef TRANSIENTMONSTER_H
+#define TRANSIENTMONSTER_H
+
+#include "monster.h"
+
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+// A Monster that owns its name and roar as std::pmr::strings, for the short-lived monsters of a wave
+// ("Goofy the 3rd", "Crusty of the north gate", ...) whose made-up names aren't worth interning in Monster::strings().
+// It is allocator-aware, so inside a std::pmr::vector whose resource is a RoundArena, both the monsters and their
+// strings come out of the arena, and the whole wave is thrown away at once with RoundArena::endRound().
+class TransientMonster {
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        TransientMonster(Monster::Type type, std::string_view name, std::string_view roar, int hitpoints, allocator_type allocator = {})
+            : m_type {type}, m_name {name, allocator}, m_roar {roar, allocator}, m_hitpoints {hitpoints} {}
+
+        // std::pmr containers copy and move elements with these, passing their own allocator
+        TransientMonster(const TransientMonster& other, allocator_type allocator = {})
+            : m_type {other.m_type}, m_name {other.m_name, allocator}, m_roar {other.m_roar, allocator}, m_hitpoints {other.m_hitpoints} {}
+        TransientMonster(TransientMonster&& other, allocator_type allocator)
+            : m_type {other.m_type}, m_name {std::move(other.m_name), allocator}, m_roar {std::move(other.m_roar), allocator}, m_hitpoints {other.m_hitpoints} {}
+        TransientMonster(TransientMonster&&) = default;
+        TransientMonster& operator=(const TransientMonster&) = default;
+        TransientMonster& operator=(TransientMonster&&) = default;
+
+        allocator_type get_allocator() const { return m_name.get_allocator(); }
+
+        Monster::Type getType() const { return m_type; }
+        std::string_view getName() const { return m_name; }
+        std::string_view getRoar() const { return m_roar; }
+        int getHitpoints() const { return m_hitpoints; }
+
+        void takeDamage(int damage) { m_hitpoints -= damage; }
+
+        // Same output as Monster::print()
+        void print() const {
+            std::cout << m_name << " the " << Monster::getTypeString(m_type);
+            if (m_hitpoints <= 0) {
+                std::cout << " is dead.\n";
+            } else {
+                std::cout << " has " << m_hitpoints << " hitpoints and says " << m_roar << ".\n";
+            }
+        }
+
+        // A permanent Monster with the same name and roar (interning them), e.g. for a monster that survives its wave
+        Monster toMonster() const { return Monster{ m_type, m_name, m_roar, m_hitpoints }; }
+
+    private:
+        Monster::Type m_type{};
+        std::pmr::string m_name{};
+        std::pmr::string m_roar{};
+        int m_hitpoints{};
+};
+
+#endif
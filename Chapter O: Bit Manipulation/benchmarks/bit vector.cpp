@@ -0,0 +1,257 @@
+/*
+BitVector vs std::vector<bool> vs Chunked std::bitset
+    Two columns of flags (10M bits by default, 1 in 4 set at random) are combined with AND, OR, XOR and AND NOT,
+    counted, and walked set bit by set bit, using:
+    * std::vector<bool>, one bit at a time through its proxy references
+    * a std::vector of std::bitset<4096> chunks, the usual way to stretch a fixed-size bitset (walked with
+      libstdc++'s _Find_first/_Find_next where available)
+    * BitVector (../bitvector.h) forced to each SIMD level this CPU supports: scalar words, SSE2 and AVX2
+    Every version's results are checked against the others, and BitVector's RankIndex is checked against a plain count
+    and timed on random rank and select queries.
+
+    Build: g++ -std=c++20 -O2 "bit vector.cpp"
+    Usage: ./a.out [bits]
+*/
+
+#include "../bitvector.h"
+
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+constexpr std::size_t chunkBits{ 4096 };
+using Chunked = std::vector<std::bitset<chunkBits>>;
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+// What every version computes, so they can be compared
+struct Results
+{
+    std::size_t andCount{};
+    std::size_t orCount{};
+    std::size_t xorCount{};
+    std::size_t andNotCount{};
+    std::size_t positionSum{}; // the sum of the positions of the set bits of a, found one at a time
+
+    friend bool operator==(const Results&, const Results&) = default;
+};
+
+void report(const char* name, std::size_t bits, double combineSeconds, double countSeconds, double walkSeconds)
+{
+    const double gbits{ static_cast<double>(bits) / 1e9 };
+    std::cout << name << "\t" << gbits * 4 / combineSeconds << "\t\t" << gbits * 5 / countSeconds << "\t\t" << gbits / walkSeconds << '\n';
+}
+
+Results runVectorBool(const std::vector<bool>& a, const std::vector<bool>& b)
+{
+    Results results{};
+    std::vector<std::vector<bool>> out(4, a);
+    const std::size_t bits{ a.size() };
+
+    const double combineSeconds{ secondsFor([&] {
+        for (std::size_t i{ 0 }; i < bits; ++i)
+        {
+            out[0][i] = a[i] && b[i];
+            out[1][i] = a[i] || b[i];
+            out[2][i] = a[i] != b[i];
+            out[3][i] = a[i] && !b[i];
+        }
+    }) };
+
+    const auto countBits = [](const std::vector<bool>& v) { return static_cast<std::size_t>(std::count(v.begin(), v.end(), true)); };
+    std::size_t aCount{};
+    const double countSeconds{ secondsFor([&] {
+        results.andCount = countBits(out[0]);
+        results.orCount = countBits(out[1]);
+        results.xorCount = countBits(out[2]);
+        results.andNotCount = countBits(out[3]);
+        aCount = countBits(a);
+    }) };
+    (void)aCount;
+
+    const double walkSeconds{ secondsFor([&] {
+        for (std::size_t i{ 0 }; i < bits; ++i)
+            if (a[i])
+                results.positionSum += i;
+    }) };
+
+    report("vector<bool>", bits, combineSeconds, countSeconds, walkSeconds);
+    return results;
+}
+
+std::size_t countChunks(const Chunked& chunks)
+{
+    std::size_t total{ 0 };
+    for (const auto& chunk : chunks)
+        total += chunk.count();
+    return total;
+}
+
+Results runChunked(const Chunked& a, const Chunked& b, std::size_t bits)
+{
+    Results results{};
+    std::vector<Chunked> out(4, a);
+
+    const double combineSeconds{ secondsFor([&] {
+        for (std::size_t c{ 0 }; c < a.size(); ++c)
+        {
+            out[0][c] &= b[c];
+            out[1][c] |= b[c];
+            out[2][c] ^= b[c];
+            out[3][c] &= ~b[c];
+        }
+    }) };
+
+    std::size_t aCount{};
+    const double countSeconds{ secondsFor([&] {
+        results.andCount = countChunks(out[0]);
+        results.orCount = countChunks(out[1]);
+        results.xorCount = countChunks(out[2]);
+        results.andNotCount = countChunks(out[3]);
+        aCount = countChunks(a);
+    }) };
+    (void)aCount;
+
+    const double walkSeconds{ secondsFor([&] {
+        for (std::size_t c{ 0 }; c < a.size(); ++c)
+        {
+#ifdef __GLIBCXX__
+            for (std::size_t i{ a[c]._Find_first() }; i < chunkBits; i = a[c]._Find_next(i))
+                results.positionSum += c * chunkBits + i;
+#else
+            for (std::size_t i{ 0 }; i < chunkBits; ++i)
+                if (a[c].test(i))
+                    results.positionSum += c * chunkBits + i;
+#endif
+        }
+    }) };
+
+    report("bitset<4096>[]", bits, combineSeconds, countSeconds, walkSeconds);
+    return results;
+}
+
+Results runBitVector(const char* name, const BitVector& a, const BitVector& b)
+{
+    Results results{};
+    std::vector<BitVector> out(4, a);
+
+    const double combineSeconds{ secondsFor([&] {
+        out[0] &= b;
+        out[1] |= b;
+        out[2] ^= b;
+        out[3].andNot(b);
+    }) };
+
+    std::size_t aCount{};
+    const double countSeconds{ secondsFor([&] {
+        results.andCount = out[0].count();
+        results.orCount = out[1].count();
+        results.xorCount = out[2].count();
+        results.andNotCount = out[3].count();
+        aCount = a.count();
+    }) };
+    (void)aCount;
+
+    const double walkSeconds{ secondsFor([&] {
+        for (std::size_t i{ a.findNext(0) }; i != a.npos(); i = a.findNext(i + 1))
+            results.positionSum += i;
+    }) };
+
+    report(name, a.size(), combineSeconds, countSeconds, walkSeconds);
+    return results;
+}
+
+// Checks RankIndex against a running count, then times random queries
+bool runRankSelect(const BitVector& a, std::mt19937_64& rng)
+{
+    const RankIndex index{ a };
+
+    bool ok{ index.count() == a.count() && index.rank(0) == 0 && index.rank(a.size()) == a.count() && index.select(a.count()) == a.size() };
+    std::size_t seen{ 0 };
+    for (std::size_t i{ 0 }; i < a.size() && ok; ++i)
+    {
+        if (i % 997 == 0)
+            ok = index.rank(i) == seen;
+        if (a.test(i))
+        {
+            if (seen % 997 == 0)
+                ok = ok && index.select(seen) == i;
+            ++seen;
+        }
+    }
+
+    constexpr std::size_t queries{ 1'000'000 };
+    std::vector<std::size_t> positions(queries);
+    for (std::size_t& position : positions)
+        position = static_cast<std::size_t>(rng() % (a.size() + 1));
+
+    std::size_t sum{ 0 };
+    const double rankSeconds{ secondsFor([&] {
+        for (std::size_t position : positions)
+            sum += index.rank(position);
+    }) };
+    const double selectSeconds{ secondsFor([&] {
+        for (std::size_t position : positions)
+            sum += index.select(position % (index.count() + 1));
+    }) };
+
+    std::cout << "\nRankIndex over " << a.size() << " bits: " << queries / rankSeconds / 1e6 << "M rank/s, "
+              << queries / selectSeconds / 1e6 << "M select/s (checksum " << sum % 1000 << "), correct: " << (ok ? "yes" : "NO") << '\n';
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t bits{ argc > 1 ? std::stoull(argv[1]) : 10'000'000 };
+
+    std::mt19937_64 rng{ 42 };
+    std::vector<bool> a(bits);
+    std::vector<bool> b(bits);
+    for (std::size_t i{ 0 }; i < bits; ++i)
+    {
+        a[i] = rng() % 4 == 0;
+        b[i] = rng() % 4 == 0;
+    }
+
+    Chunked chunkedA((bits + chunkBits - 1) / chunkBits);
+    Chunked chunkedB(chunkedA.size());
+    BitVector vectorA(bits);
+    BitVector vectorB(bits);
+    for (std::size_t i{ 0 }; i < bits; ++i)
+    {
+        chunkedA[i / chunkBits][i % chunkBits] = a[i];
+        chunkedB[i / chunkBits][i % chunkBits] = b[i];
+        vectorA.set(i, a[i]);
+        vectorB.set(i, b[i]);
+    }
+
+    std::cout << bits << " bits, Gbit/s for:\t4 bulk ops\t5 counts\twalking set bits\n";
+    const Results expected{ runVectorBool(a, b) };
+    bool ok{ runChunked(chunkedA, chunkedB, bits) == expected };
+
+    const Simd::Level best{ Simd::detected() };
+    constexpr const char* levelNames[]{ "BitVector scalar", "BitVector SSE2", "BitVector AVX2" };
+    for (auto level{ Simd::Level::scalar }; level <= best; level = static_cast<Simd::Level>(static_cast<int>(level) + 1))
+    {
+        Simd::use(level);
+        ok = runBitVector(levelNames[static_cast<int>(level)], vectorA, vectorB) == expected && ok;
+    }
+    Simd::use(best);
+
+    ok = runRankSelect(vectorA, rng) && ok;
+    std::cout << "all versions agree: " << (ok ? "yes" : "NO") << '\n';
+
+    return ok ? 0 : 1;
+}
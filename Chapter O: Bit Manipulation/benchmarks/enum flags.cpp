@@ -0,0 +1,230 @@
+/*
+EnumFlags vs Hand-Written Masks
+    Each operation is written twice, once with raw std::uint8_t masks as in "bit masks.cpp" and once with EnumFlags<Emotion>
+    (../enumflags.h), as separate functions the compiler can neither inline nor merge (gnu::noipa). Then the program:
+    * runs each pair on all 256 possible flag bytes and checks they give the same results,
+    * disassembles itself with objdump (from binutils, which has to be on the PATH) and checks each pair compiled to the
+      same instructions, ignoring addresses and the padding between functions, and prints both listings if they don't,
+    * and times both versions of a loop over 50M flag bytes.
+    It returns 1 if any pair gives different results or different code, so it fails when built without optimization
+    (at -O0 every EnumFlags member is a real call). To read the code yourself:
+        objdump -d --no-show-raw-insn -C a.out | grep -A8 -E "<(hand|flags)Set"
+
+    Build: g++ -std=c++20 -O2 "enum flags.cpp"
+    Usage: ./a.out [flag bytes]
+*/
+
+#include "../enumflags.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum class Emotion { hungry, sad, mad, happy, laughing, asleep, dead, crying, maxFlags };
+using Flags = EnumFlags<Emotion>;
+static_assert(sizeof(Flags) == sizeof(std::uint8_t));
+
+constexpr std::uint8_t mask1{ 0b0000'0010 };
+constexpr std::uint8_t mask2{ 0b0000'0100 };
+constexpr std::uint8_t mask3{ 0b0000'1000 };
+
+[[gnu::noipa]] std::uint8_t handSet(std::uint8_t f) { return f | mask3; }
+[[gnu::noipa]] Flags flagsSet(Flags f) { return f.set(Emotion::happy); }
+
+[[gnu::noipa]] std::uint8_t handReset(std::uint8_t f) { return static_cast<std::uint8_t>(f & ~(mask1 | mask2)); }
+[[gnu::noipa]] Flags flagsReset(Flags f) { return f.reset(Emotion::sad | Emotion::mad); }
+
+[[gnu::noipa]] std::uint8_t handFlip(std::uint8_t f) { return f ^ (mask1 | mask2); }
+[[gnu::noipa]] Flags flagsFlip(Flags f) { return f.flip(Emotion::sad | Emotion::mad); }
+
+[[gnu::noipa]] bool handTest(std::uint8_t f) { return (f & mask3) != 0; }
+[[gnu::noipa]] bool flagsTest(Flags f) { return f.test(Emotion::happy); }
+
+[[gnu::noipa]] bool handAll(std::uint8_t f) { return f == 0xFF; }
+[[gnu::noipa]] bool flagsAll(Flags f) { return f.all(); }
+
+[[gnu::noipa]] bool handNone(std::uint8_t f) { return f == 0; }
+[[gnu::noipa]] bool flagsNone(Flags f) { return f.none(); }
+
+[[gnu::noipa]] int handCount(std::uint8_t f) { return std::popcount(f); }
+[[gnu::noipa]] int flagsCount(Flags f) { return f.count(); }
+
+// Results as plain integers, so a mask and an EnumFlags can be compared
+int asInt(std::uint8_t bits) { return bits; }
+int asInt(Flags flags) { return flags.bits(); }
+int asInt(bool value) { return value; }
+int asInt(int value) { return value; }
+
+// The instructions of every function in a program, by name without the parameter list
+using Disassembly = std::map<std::string, std::vector<std::string>>;
+
+// Rewrites one objdump instruction so it doesn't depend on where the function was placed:
+// "call   1110 <__popcountdi2@plt>" becomes "call <__popcountdi2@plt>", and a jump inside function to
+// "18b4 <handTest(unsigned char)+0x4>" becomes "jmp <+0x4>"
+std::string normalize(const std::string& instruction, const std::string& function)
+{
+    std::istringstream in{ instruction };
+    std::string mnemonic{};
+    in >> mnemonic;
+    std::string operands{};
+    std::getline(in >> std::ws, operands);
+
+    if (const std::size_t target{ operands.find(" <") }; target != std::string::npos && operands.back() == '>')
+    {
+        std::string symbol{ operands.substr(target + 2, operands.size() - target - 3) };
+        if (symbol.compare(0, function.size(), function) == 0 && (symbol.size() == function.size() || symbol[function.size()] == '('))
+            symbol = symbol.substr(std::min(symbol.find('+'), symbol.size()));
+        operands = '<' + symbol + '>';
+    }
+    return operands.empty() ? mnemonic : mnemonic + ' ' + operands;
+}
+
+// Reads one whole line from file (demangled template names can run to thousands of characters)
+bool readLine(FILE* file, std::string& line)
+{
+    line.clear();
+    char buffer[1024]{};
+    while (std::fgets(buffer, sizeof(buffer), file))
+    {
+        line += buffer;
+        if (line.back() == '\n')
+        {
+            line.pop_back();
+            return true;
+        }
+    }
+    return !line.empty();
+}
+
+// Disassembles program with objdump. Returns an empty map if that didn't work.
+Disassembly disassemble(const char* program)
+{
+    Disassembly functions{};
+    const std::string command{ "objdump -d --no-show-raw-insn -C '" + std::string{ program } + "' 2>/dev/null" };
+    FILE* pipe{ popen(command.c_str(), "r") }; // POSIX
+    if (!pipe)
+        return functions;
+
+    std::vector<std::string>* current{ nullptr };
+    std::string function{};
+    for (std::string line{}; readLine(pipe, line);)
+    {
+        // "0000000000001840 <handSet(unsigned char)>:" starts a function
+        if (const std::size_t open{ line.find(" <") }; open != std::string::npos && line.size() > 2 && line.compare(line.size() - 2, 2, ">:") == 0)
+        {
+            const std::string symbol{ line.substr(open + 2, line.size() - open - 4) };
+            function = symbol.substr(0, symbol.find('('));
+            current = &functions[function];
+            continue;
+        }
+
+        // "    1840:\tmov    %edi,%eax"; the nops are padding up to the next function
+        const std::size_t tab{ line.find(":\t") };
+        if (!current || tab == std::string::npos)
+            continue;
+        const std::string instruction{ line.substr(tab + 2) };
+        if (instruction.find("nop") != std::string::npos || instruction == "int3")
+            continue;
+        current->push_back(normalize(instruction, function));
+    }
+    pclose(pipe);
+    return functions;
+}
+
+// Runs both versions of an operation on every possible flag byte and compares their instructions.
+// Returns true if the results always agree and the code is the same.
+template <typename A, typename B>
+bool compare(const char* name, A* hand, const char* handName, B* flags, const char* flagsName, const Disassembly& code)
+{
+    int mismatches{ 0 };
+    for (int bits{ 0 }; bits < 256; ++bits)
+    {
+        const auto f{ static_cast<std::uint8_t>(bits) };
+        mismatches += asInt(hand(f)) != asInt(flags(Flags::fromBits(f)));
+    }
+
+    const auto handCode{ code.find(handName) };
+    const auto flagsCode{ code.find(flagsName) };
+    const bool found{ handCode != code.end() && flagsCode != code.end() };
+    const bool sameCode{ found && handCode->second == flagsCode->second };
+
+    std::cout << name << "\t" << (mismatches == 0 ? "same" : "DIFFERENT") << "\t"
+              << (sameCode ? "same (" + std::to_string(handCode->second.size()) + " instructions)" : found ? "DIFFERENT" : "not found")
+              << '\n';
+    if (found && !sameCode)
+    {
+        for (const auto* function : { &*handCode, &*flagsCode })
+        {
+            std::cout << "    " << function->first << ":\n";
+            for (const std::string& instruction : function->second)
+                std::cout << "        " << instruction << '\n';
+        }
+    }
+    return mismatches == 0 && sameCode;
+}
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t count{ argc > 1 ? std::stoull(argv[1]) : 50'000'000 };
+
+    const Disassembly code{ disassemble(argv[0]) };
+    if (code.empty())
+        std::cout << "couldn't disassemble " << argv[0] << " with objdump, so the code can't be compared\n";
+
+    std::cout << "operation\tresults for all 256 flag bytes\tmachine code\n";
+    bool ok{ compare("set", handSet, "handSet", flagsSet, "flagsSet", code) };
+    ok = compare("reset", handReset, "handReset", flagsReset, "flagsReset", code) && ok;
+    ok = compare("flip", handFlip, "handFlip", flagsFlip, "flagsFlip", code) && ok;
+    ok = compare("test", handTest, "handTest", flagsTest, "flagsTest", code) && ok;
+    ok = compare("all", handAll, "handAll", flagsAll, "flagsAll", code) && ok;
+    ok = compare("none", handNone, "handNone", flagsNone, "flagsNone", code) && ok;
+    ok = compare("count", handCount, "handCount", flagsCount, "flagsCount", code) && ok;
+
+    // the same loop over a column of flag bytes, written both ways (these ones may be inlined and vectorized)
+    std::vector<std::uint8_t> raw(count);
+    for (std::size_t i{ 0 }; i < count; ++i)
+        raw[i] = static_cast<std::uint8_t>(i * 2654435761u >> 24);
+    std::vector<Flags> flags(count);
+    for (std::size_t i{ 0 }; i < count; ++i)
+        flags[i] = Flags::fromBits(raw[i]);
+
+    std::size_t handHappy{ 0 };
+    const double handSeconds{ secondsFor([&] {
+        for (std::uint8_t& f : raw)
+        {
+            f = static_cast<std::uint8_t>((f ^ (mask1 | mask2)) | mask3);
+            handHappy += (f & mask3) != 0 && (f & mask1) == 0;
+        }
+    }) };
+
+    std::size_t flagsHappy{ 0 };
+    const double flagsSeconds{ secondsFor([&] {
+        for (Flags& f : flags)
+        {
+            f.flip(Emotion::sad | Emotion::mad).set(Emotion::happy);
+            flagsHappy += f.test(Emotion::happy) && !f.test(Emotion::sad);
+        }
+    }) };
+
+    const bool same{ handHappy == flagsHappy && std::memcmp(raw.data(), flags.data(), count) == 0 };
+    std::cout << "loop\tmasks " << static_cast<double>(count) / handSeconds << "/s\tEnumFlags " << static_cast<double>(count) / flagsSeconds
+              << "/s\tsame results: " << (same ? "yes" : "NO") << '\n';
+
+    return ok && same ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+/*
+Splitting RGBA Frames into Planes
+    Times Pixels::split and Pixels::merge (../pixelplanes.h) on a 4K frame (3840 x 2160 RGBA8888 pixels, 33 MB) at every
+    SIMD level this CPU supports, and checks each level against the one-pixel-at-a-time masks and shifts from "bit masks.cpp":
+    * split must give the same four channels as the masks and shifts, for frames of every length from 0 to 100 pixels
+      (so every SIMD loop's leftover pixels are covered) as well as the full frame,
+    * and merge must rebuild the original pixels.
+    A frame moves 33 MB in and 33 MB out, so once the loops are vectorized the time is set by memory bandwidth, not
+    by the shuffles: a frame that isn't in cache takes a few milliseconds on one core however the pixels are rearranged.
+    Smaller frames that fit in cache (e.g. ./a.out 256 256 200) show the speed of the loops themselves.
+
+    Build: g++ -std=c++20 -O2 "pixel planes.cpp"
+    Usage: ./a.out [width] [height] [repeats]
+*/
+
+#include "../pixelplanes.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// "bit masks.cpp" on one pixel at a time, kept separate from the header so the check doesn't test the code against itself
+struct Reference
+{
+    std::vector<std::uint8_t> red{};
+    std::vector<std::uint8_t> green{};
+    std::vector<std::uint8_t> blue{};
+    std::vector<std::uint8_t> alpha{};
+
+    explicit Reference(const std::vector<std::uint32_t>& pixels)
+    {
+        constexpr std::uint32_t redBits{ 0xFF000000 };
+        constexpr std::uint32_t greenBits{ 0x00FF0000 };
+        constexpr std::uint32_t blueBits{ 0x0000FF00 };
+        constexpr std::uint32_t alphaBits{ 0x000000FF };
+
+        for (std::uint32_t pixel : pixels)
+        {
+            red.push_back(static_cast<std::uint8_t>((pixel & redBits) >> 24));
+            green.push_back(static_cast<std::uint8_t>((pixel & greenBits) >> 16));
+            blue.push_back(static_cast<std::uint8_t>((pixel & blueBits) >> 8));
+            alpha.push_back(static_cast<std::uint8_t>(pixel & alphaBits));
+        }
+    }
+};
+
+struct Frame
+{
+    std::vector<std::uint8_t> red{};
+    std::vector<std::uint8_t> green{};
+    std::vector<std::uint8_t> blue{};
+    std::vector<std::uint8_t> alpha{};
+
+    explicit Frame(std::size_t pixels) : red(pixels), green(pixels), blue(pixels), alpha(pixels) {}
+
+    Pixels::Planes planes() { return { red, green, blue, alpha }; }
+};
+
+std::vector<std::uint32_t> randomPixels(std::size_t count, std::mt19937& rng)
+{
+    std::vector<std::uint32_t> pixels(count);
+    for (std::uint32_t& pixel : pixels)
+        pixel = static_cast<std::uint32_t>(rng());
+    return pixels;
+}
+
+// Splits and merges pixels at the current level and compares the results with the masks and shifts
+bool matchesReference(const std::vector<std::uint32_t>& pixels)
+{
+    const Reference expected{ pixels };
+    Frame frame{ pixels.size() };
+    Pixels::split(pixels, frame.planes());
+
+    std::vector<std::uint32_t> merged(pixels.size());
+    Pixels::merge(frame.planes(), merged);
+
+    return frame.red == expected.red && frame.green == expected.green && frame.blue == expected.blue && frame.alpha == expected.alpha
+        && merged == pixels;
+}
+
+template <typename F>
+double secondsFor(F&& fn)
+{
+    const auto start{ std::chrono::steady_clock::now() };
+    fn();
+    return std::chrono::duration<double>{ std::chrono::steady_clock::now() - start }.count();
+}
+
+int main(int argc, char* argv[])
+{
+    const std::size_t width{ argc > 1 ? std::stoull(argv[1]) : 3840 };
+    const std::size_t height{ argc > 2 ? std::stoull(argv[2]) : 2160 };
+    const int repeats{ argc > 3 ? std::stoi(argv[3]) : 20 };
+    const std::size_t count{ width * height };
+
+    std::mt19937 rng{ 42 };
+    const std::vector<std::uint32_t> pixels{ randomPixels(count, rng) };
+    Frame frame{ count };
+    std::vector<std::uint32_t> merged(count);
+
+    constexpr const char* levelNames[]{ "scalar", "SSE2", "AVX2" };
+    const Simd::Level best{ Simd::detected() };
+    const double megabytes{ static_cast<double>(count * sizeof(std::uint32_t) * 2) / 1e6 }; // read plus written
+
+    std::cout << width << " x " << height << " frame, best of " << repeats << " runs\n";
+    std::cout << "level\tsplit ms\tsplit GB/s\tmerge ms\tmerge GB/s\tcorrect\n";
+
+    bool ok{ true };
+    for (auto level{ Simd::Level::scalar }; level <= best; level = static_cast<Simd::Level>(static_cast<int>(level) + 1))
+    {
+        Simd::use(level);
+
+        bool correct{ matchesReference(pixels) };
+        for (std::size_t length{ 0 }; length <= 100 && correct; ++length)
+            correct = matchesReference(randomPixels(length, rng));
+        ok = ok && correct;
+
+        double splitSeconds{ 1e9 };
+        double mergeSeconds{ 1e9 };
+        for (int run{ 0 }; run < repeats; ++run)
+        {
+            splitSeconds = std::min(splitSeconds, secondsFor([&] { Pixels::split(pixels, frame.planes()); }));
+            mergeSeconds = std::min(mergeSeconds, secondsFor([&] { Pixels::merge(frame.planes(), merged); }));
+        }
+
+        std::cout << levelNames[static_cast<int>(level)] << '\t' << splitSeconds * 1e3 << "\t\t" << megabytes / 1e3 / splitSeconds << "\t\t"
+                  << mergeSeconds * 1e3 << "\t\t" << megabytes / 1e3 / mergeSeconds << "\t\t" << (correct ? "yes" : "NO") << '\n';
+    }
+    Simd::use(best);
+
+    return ok ? 0 : 1;
+}
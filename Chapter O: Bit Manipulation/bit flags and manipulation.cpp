@@ -23,6 +23,11 @@ Bit Manipulation
 
     
     Setting or obtaining multiple bits at once is difficult with std::bitset. In addition, it is optimized for speed, not memory, meaning even a bitset of 8 can occupy far more than 1 byte.
+
+    The flag names below are loose ints, so nothing stops me.set(7) or me.test(someOtherIndex). enumflags.h names the flags with a scoped enum instead:
+    EnumFlags<Emotion> takes only Emotion enumerators, handles several flags at once, and is exactly 1 byte.
+    std::bitset also needs its size at compile time. For a column of millions of flags sized at runtime, see bitvector.h,
+    whose bulk operations, counting and searching run a SIMD register at a time (benchmarks/bit vector.cpp).
 */
 
 /*
@@ -40,8 +45,25 @@ Bitwise Operators
 
 
 #include <bitset>
+#include <cstdint>
 #include <iostream>
 
+#include "enumflags.h"
+
+enum class Emotion
+{
+    hungry,
+    sad,
+    mad,
+    happy,
+    laughing,
+    asleep,
+    dead,
+    crying,
+
+    maxFlags, // the number of flags, needed by EnumFlags
+};
+
 int main()
 {
     std::bitset<8> bits{ 0b0000'0101 }; // we need 8 bits, start with bit pattern 0000 0101
@@ -71,6 +93,21 @@ int main()
     std::cout << "I am happy: " << me.test(isHappy) << '\n';
     std::cout << "I am laughing: " << me.test(isLaughing) << '\n';
 
+    // the same thing with EnumFlags
+    EnumFlags<Emotion> feelings{ Emotion::hungry, Emotion::mad }; // 0000 0101
+    feelings.set(Emotion::happy);     // 0000 1101
+    feelings.flip(Emotion::laughing); // 0001 1101
+    feelings.reset(Emotion::laughing); // 0000 1101
+    feelings.set(Emotion::sad | Emotion::crying); // several at once: 1000 1111
+
+    std::cout << "All the bits: " << std::bitset<8>{ feelings.bits() } << " (" << sizeof(feelings) << " byte)\n";
+    std::cout << "I am happy: " << feelings.test(Emotion::happy) << '\n';
+    std::cout << "Flags set: " << feelings.count() << ", at positions:";
+    for (Emotion emotion : feelings)
+        std::cout << ' ' << static_cast<int>(emotion);
+    std::cout << '\n';
+    // feelings.set(3); // compile error: only Emotion flags go in an EnumFlags<Emotion>
+
     std::bitset<4> x { 0b1100 };
 
     std::cout << x << '\n';
@@ -3,6 +3,9 @@ Bit Masks
     A bit mask is a predefined set of bits that only allows operations to occur on specific bit positions, and prevent changes to others.
     They can be literals, but are often symbolic constants for reuse and clear meaning.
     C++ 11 and before don't support binary literals, but hex or a shifted 1 can work as well.
+
+    The RGBA example at the end takes one pixel apart at a time. pixelplanes.h does the same to whole frames with SIMD
+    (benchmarks/pixel planes.cpp checks it against these masks and shifts).
 */
 
 #include <cstdint>
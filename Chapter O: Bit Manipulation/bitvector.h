@@ -0,0 +1,493 @@
+#ifndef BITVECTOR_H
+#define BITVECTOR_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "simddispatch.h"
+
+// A runtime-sized bitset for flag columns with millions of bits.
+// std::bitset<N> needs its size at compile time, and std::vector<bool> hides its words behind proxy references, so
+// neither gets bulk operations that run a vector register at a time. BitVector keeps its bits in 64-bit words:
+//   * the storage is 64-byte aligned and padded with zero words to a whole number of cache lines, so the SIMD loops
+//     use aligned loads and never need a scalar tail
+//   * &=, |=, ^= and andNot() combine whole vectors, count() is a popcount of everything, and findNext() skips
+//     empty stretches a register at a time
+//   * RankIndex (below) answers rank (how many set bits come before i) and select (where is the k-th set bit)
+//
+// The bulk loops are compiled three times, for AVX2, SSE2 and plain 64-bit words, and run at Simd::level() (simddispatch.h):
+// the best one the CPU running the program supports, unless Simd::use() forced a slower one.
+namespace BitVectorSimd
+{
+    enum class Op
+    {
+        bitAnd,
+        bitOr,
+        bitXor,
+        bitAndNot, // a & ~b
+    };
+
+    namespace detail
+    {
+        constexpr std::size_t wordsPerLine{ 8 }; // 64 bytes
+
+        template <Op op>
+        constexpr std::uint64_t apply(std::uint64_t a, std::uint64_t b)
+        {
+            if constexpr (op == Op::bitAnd)
+                return a & b;
+            else if constexpr (op == Op::bitOr)
+                return a | b;
+            else if constexpr (op == Op::bitXor)
+                return a ^ b;
+            else
+                return a & ~b;
+        }
+
+        template <Op op>
+        void combineScalar(std::uint64_t* a, const std::uint64_t* b, std::size_t words)
+        {
+            for (std::size_t i{ 0 }; i < words; ++i)
+                a[i] = apply<op>(a[i], b[i]);
+        }
+
+        inline std::uint64_t countScalar(const std::uint64_t* words, std::size_t count)
+        {
+            std::uint64_t total{ 0 };
+            for (std::size_t i{ 0 }; i < count; ++i)
+                total += static_cast<std::uint64_t>(std::popcount(words[i]));
+            return total;
+        }
+
+        // Index of the first nonzero word in [from, count), or count
+        inline std::size_t nonZeroScalar(const std::uint64_t* words, std::size_t from, std::size_t count)
+        {
+            while (from < count && words[from] == 0)
+                ++from;
+            return from;
+        }
+
+#ifdef SIMD_X86
+        template <Op op>
+        void combineSse2(std::uint64_t* a, const std::uint64_t* b, std::size_t words)
+        {
+            for (std::size_t i{ 0 }; i < words; i += 2)
+            {
+                const __m128i x{ _mm_load_si128(reinterpret_cast<const __m128i*>(a + i)) };
+                const __m128i y{ _mm_load_si128(reinterpret_cast<const __m128i*>(b + i)) };
+                __m128i result{};
+                if constexpr (op == Op::bitAnd)
+                    result = _mm_and_si128(x, y);
+                else if constexpr (op == Op::bitOr)
+                    result = _mm_or_si128(x, y);
+                else if constexpr (op == Op::bitXor)
+                    result = _mm_xor_si128(x, y);
+                else
+                    result = _mm_andnot_si128(y, x); // andnot negates its first operand
+                _mm_store_si128(reinterpret_cast<__m128i*>(a + i), result);
+            }
+        }
+
+        template <Op op>
+        [[gnu::target("avx2")]] void combineAvx2(std::uint64_t* a, const std::uint64_t* b, std::size_t words)
+        {
+            for (std::size_t i{ 0 }; i < words; i += 4)
+            {
+                const __m256i x{ _mm256_load_si256(reinterpret_cast<const __m256i*>(a + i)) };
+                const __m256i y{ _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i)) };
+                __m256i result{};
+                if constexpr (op == Op::bitAnd)
+                    result = _mm256_and_si256(x, y);
+                else if constexpr (op == Op::bitOr)
+                    result = _mm256_or_si256(x, y);
+                else if constexpr (op == Op::bitXor)
+                    result = _mm256_xor_si256(x, y);
+                else
+                    result = _mm256_andnot_si256(y, x);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(a + i), result);
+            }
+        }
+
+        // Without AVX2 the popcnt instruction is the fastest way to count, one word at a time.
+        // Four running totals keep consecutive popcnts from waiting on each other's additions.
+        [[gnu::target("popcnt")]] inline std::uint64_t countPopcnt(const std::uint64_t* words, std::size_t count)
+        {
+            std::uint64_t totals[4]{};
+            for (std::size_t i{ 0 }; i < count; i += 4)
+                for (std::size_t k{ 0 }; k < 4; ++k)
+                    totals[k] += static_cast<std::uint64_t>(__builtin_popcountll(words[i + k]));
+            return totals[0] + totals[1] + totals[2] + totals[3];
+        }
+
+        // Mula's vpshufb popcount: look up the bit count of each 4-bit nibble in a 16-entry table, 32 bytes at a time,
+        // and let vpsadbw sum the byte counts into four 64-bit totals. Beats popcnt on long arrays.
+        [[gnu::target("avx2")]] inline std::uint64_t countAvx2(const std::uint64_t* words, std::size_t count)
+        {
+            const __m256i table{ _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                  0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4) };
+            const __m256i lowNibbles{ _mm256_set1_epi8(0x0F) };
+            __m256i totals{ _mm256_setzero_si256() };
+
+            for (std::size_t i{ 0 }; i < count; i += 4)
+            {
+                const __m256i v{ _mm256_load_si256(reinterpret_cast<const __m256i*>(words + i)) };
+                const __m256i low{ _mm256_shuffle_epi8(table, _mm256_and_si256(v, lowNibbles)) };
+                const __m256i high{ _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbles)) };
+                totals = _mm256_add_epi64(totals, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+            }
+
+            return static_cast<std::uint64_t>(_mm256_extract_epi64(totals, 0)) + static_cast<std::uint64_t>(_mm256_extract_epi64(totals, 1))
+                 + static_cast<std::uint64_t>(_mm256_extract_epi64(totals, 2)) + static_cast<std::uint64_t>(_mm256_extract_epi64(totals, 3));
+        }
+
+        inline std::size_t nonZeroSse2(const std::uint64_t* words, std::size_t from, std::size_t count)
+        {
+            for (; from < count && from % 2 != 0; ++from)
+                if (words[from] != 0)
+                    return from;
+
+            const __m128i zero{ _mm_setzero_si128() };
+            for (; from < count; from += 2)
+            {
+                const __m128i v{ _mm_load_si128(reinterpret_cast<const __m128i*>(words + from)) };
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xFFFF)
+                    return words[from] != 0 ? from : from + 1;
+            }
+            return count;
+        }
+
+        [[gnu::target("avx2")]] inline std::size_t nonZeroAvx2(const std::uint64_t* words, std::size_t from, std::size_t count)
+        {
+            for (; from < count && from % 4 != 0; ++from)
+                if (words[from] != 0)
+                    return from;
+
+            for (; from < count; from += 4)
+            {
+                const __m256i v{ _mm256_load_si256(reinterpret_cast<const __m256i*>(words + from)) };
+                if (!_mm256_testz_si256(v, v))
+                    return nonZeroScalar(words, from, from + 4);
+            }
+            return count;
+        }
+#endif
+
+        // The word counts passed in are always whole cache lines, so every loop above divides evenly
+        template <Op op>
+        void combine(std::uint64_t* a, const std::uint64_t* b, std::size_t words)
+        {
+            switch (Simd::level())
+            {
+#ifdef SIMD_X86
+            case Simd::Level::avx2: combineAvx2<op>(a, b, words); return;
+            case Simd::Level::sse2: combineSse2<op>(a, b, words); return;
+#endif
+            default: combineScalar<op>(a, b, words); return;
+            }
+        }
+
+        inline std::uint64_t count(const std::uint64_t* words, std::size_t count)
+        {
+            switch (Simd::level())
+            {
+#ifdef SIMD_X86
+            case Simd::Level::avx2: return countAvx2(words, count);
+            case Simd::Level::sse2: return Simd::hasPopcnt() ? countPopcnt(words, count) : countScalar(words, count);
+#endif
+            default: return countScalar(words, count);
+            }
+        }
+
+        inline std::size_t nonZero(const std::uint64_t* words, std::size_t from, std::size_t count)
+        {
+            switch (Simd::level())
+            {
+#ifdef SIMD_X86
+            case Simd::Level::avx2: return nonZeroAvx2(words, from, count);
+            case Simd::Level::sse2: return nonZeroSse2(words, from, count);
+#endif
+            default: return nonZeroScalar(words, from, count);
+            }
+        }
+    }
+}
+
+class BitVector
+{
+public:
+    BitVector() = default;
+
+    explicit BitVector(std::size_t size, bool value = false)
+        : m_size{ size }, m_wordCount{ paddedWords(size) }, m_words{ allocate(m_wordCount) }
+    {
+        if (value)
+            set();
+    }
+
+    BitVector(const BitVector& other) : m_size{ other.m_size }, m_wordCount{ other.m_wordCount }, m_words{ allocate(m_wordCount) }
+    {
+        std::copy_n(other.m_words.get(), m_wordCount, m_words.get()); // unlike memcpy, fine with the null words of an empty BitVector
+    }
+
+    BitVector& operator=(const BitVector& other)
+    {
+        if (this != &other)
+            *this = BitVector{ other };
+        return *this;
+    }
+
+    // Moving leaves the source valid: a move-constructed-from BitVector is empty, a move-assigned-from one holds the old bits
+    BitVector(BitVector&& other) noexcept
+        : m_size{ std::exchange(other.m_size, 0) }, m_wordCount{ std::exchange(other.m_wordCount, 0) }, m_words{ std::move(other.m_words) }
+    {
+    }
+
+    BitVector& operator=(BitVector&& other) noexcept
+    {
+        std::swap(m_size, other.m_size);
+        std::swap(m_wordCount, other.m_wordCount);
+        std::swap(m_words, other.m_words);
+        return *this;
+    }
+
+    // Returned by findNext() when there are no more set bits
+    std::size_t npos() const { return m_size; }
+
+    std::size_t size() const { return m_size; }
+
+    // The words holding the bits (bit i is bit i % 64 of word i / 64), including the zero padding
+    std::span<std::uint64_t> words() { return { m_words.get(), m_wordCount }; }
+    std::span<const std::uint64_t> words() const { return { m_words.get(), m_wordCount }; }
+
+    bool test(std::size_t i) const
+    {
+        assert(i < m_size);
+        return (m_words[i / 64] >> (i % 64)) & 1;
+    }
+
+    void set(std::size_t i)
+    {
+        assert(i < m_size);
+        m_words[i / 64] |= bit(i);
+    }
+
+    void set(std::size_t i, bool value)
+    {
+        assert(i < m_size);
+        m_words[i / 64] = (m_words[i / 64] & ~bit(i)) | (static_cast<std::uint64_t>(value) << (i % 64));
+    }
+
+    void reset(std::size_t i)
+    {
+        assert(i < m_size);
+        m_words[i / 64] &= ~bit(i);
+    }
+
+    void flip(std::size_t i)
+    {
+        assert(i < m_size);
+        m_words[i / 64] ^= bit(i);
+    }
+
+    void set()
+    {
+        std::fill_n(m_words.get(), m_size / 64, ~std::uint64_t{ 0 });
+        if (m_size % 64 != 0)
+            m_words[m_size / 64] = (std::uint64_t{ 1 } << (m_size % 64)) - 1;
+    }
+
+    void reset() { std::fill_n(m_words.get(), m_wordCount, std::uint64_t{ 0 }); }
+
+    void flip()
+    {
+        for (std::size_t i{ 0 }; i < usedWords(); ++i)
+            m_words[i] = ~m_words[i];
+        clearPastEnd();
+    }
+
+    // The bulk operations need both vectors to be the same size
+    BitVector& operator&=(const BitVector& other) { return combine<BitVectorSimd::Op::bitAnd>(other); }
+    BitVector& operator|=(const BitVector& other) { return combine<BitVectorSimd::Op::bitOr>(other); }
+    BitVector& operator^=(const BitVector& other) { return combine<BitVectorSimd::Op::bitXor>(other); }
+    // Clears every bit that is set in other (*this &= ~other, without building ~other)
+    BitVector& andNot(const BitVector& other) { return combine<BitVectorSimd::Op::bitAndNot>(other); }
+
+    friend BitVector operator&(BitVector a, const BitVector& b) { a &= b; return a; }
+    friend BitVector operator|(BitVector a, const BitVector& b) { a |= b; return a; }
+    friend BitVector operator^(BitVector a, const BitVector& b) { a ^= b; return a; }
+
+    friend bool operator==(const BitVector& a, const BitVector& b)
+    {
+        return a.m_size == b.m_size && std::equal(a.m_words.get(), a.m_words.get() + a.m_wordCount, b.m_words.get());
+    }
+
+    // The number of set bits
+    std::size_t count() const { return static_cast<std::size_t>(BitVectorSimd::detail::count(m_words.get(), m_wordCount)); }
+
+    bool any() const { return findNext(0) != npos(); }
+    bool none() const { return !any(); }
+    bool all() const { return count() == m_size; }
+
+    // The position of the first set bit at or after from, or npos() if there isn't one
+    // Sample loop over the set bits: for (std::size_t i{ bits.findNext(0) }; i != bits.npos(); i = bits.findNext(i + 1))
+    std::size_t findNext(std::size_t from) const
+    {
+        if (from >= m_size)
+            return npos();
+
+        std::size_t word{ from / 64 };
+        const std::uint64_t first{ m_words[word] & (~std::uint64_t{ 0 } << (from % 64)) };
+        if (first != 0)
+            return word * 64 + static_cast<std::size_t>(std::countr_zero(first));
+
+        word = BitVectorSimd::detail::nonZero(m_words.get(), word + 1, m_wordCount);
+        if (word == m_wordCount)
+            return npos();
+        return word * 64 + static_cast<std::size_t>(std::countr_zero(m_words[word]));
+    }
+
+private:
+    struct AlignedDelete
+    {
+        void operator()(std::uint64_t* words) const { ::operator delete[](words, std::align_val_t{ alignment }); }
+    };
+
+    static constexpr std::size_t alignment{ 64 };
+
+    std::size_t m_size{ 0 };
+    std::size_t m_wordCount{ 0 };
+    std::unique_ptr<std::uint64_t[], AlignedDelete> m_words{};
+
+    // Whole cache lines, zeroed
+    static std::size_t paddedWords(std::size_t size)
+    {
+        constexpr std::size_t bitsPerLine{ BitVectorSimd::detail::wordsPerLine * 64 };
+        return (size + bitsPerLine - 1) / bitsPerLine * BitVectorSimd::detail::wordsPerLine;
+    }
+
+    static std::unique_ptr<std::uint64_t[], AlignedDelete> allocate(std::size_t words)
+    {
+        if (words == 0)
+            return {};
+        auto* storage{ static_cast<std::uint64_t*>(::operator new[](words * sizeof(std::uint64_t), std::align_val_t{ alignment })) };
+        std::fill_n(storage, words, std::uint64_t{ 0 });
+        return std::unique_ptr<std::uint64_t[], AlignedDelete>{ storage };
+    }
+
+    static std::uint64_t bit(std::size_t i) { return std::uint64_t{ 1 } << (i % 64); }
+
+    std::size_t usedWords() const { return (m_size + 63) / 64; }
+
+    // Keeps the bits past size() zero, which count(), findNext() and operator== rely on
+    void clearPastEnd()
+    {
+        if (m_size % 64 != 0)
+            m_words[m_size / 64] &= (std::uint64_t{ 1 } << (m_size % 64)) - 1;
+    }
+
+    template <BitVectorSimd::Op op>
+    BitVector& combine(const BitVector& other)
+    {
+        assert(m_size == other.m_size);
+        BitVectorSimd::detail::combine<op>(m_words.get(), other.m_words.get(), m_wordCount);
+        return *this;
+    }
+};
+
+// Rank and select over a BitVector, using the set-bit count before each 512-bit block (one cache line of words):
+//   rank(i)   = how many bits before position i are set: one table lookup plus at most 8 popcounts
+//   select(k) = the position of the k-th set bit (counting from 0): a binary search of the table, then a scan of one block
+// The index takes 1/8 of the bitset's memory. It describes the bits as they were when it was built,
+// so build a new one after changing the BitVector.
+class RankIndex
+{
+public:
+    explicit RankIndex(const BitVector& bits) : m_bits{ &bits }
+    {
+        const std::span<const std::uint64_t> words{ bits.words() };
+        const std::size_t blocks{ words.size() / wordsPerBlock };
+
+        m_before.resize(blocks + 1);
+        for (std::size_t block{ 0 }; block < blocks; ++block)
+            m_before[block + 1] = m_before[block] + BitVectorSimd::detail::count(words.data() + block * wordsPerBlock, wordsPerBlock);
+    }
+
+    // The total number of set bits
+    std::size_t count() const { return static_cast<std::size_t>(m_before.back()); }
+
+    // The number of set bits in positions [0, i), for i up to size()
+    std::size_t rank(std::size_t i) const
+    {
+        assert(i <= m_bits->size());
+        const std::uint64_t* words{ m_bits->words().data() };
+        const std::size_t word{ i / 64 };
+        const std::size_t block{ word / wordsPerBlock };
+
+        std::uint64_t result{ m_before[block] };
+        for (std::size_t w{ block * wordsPerBlock }; w < word; ++w)
+            result += static_cast<std::uint64_t>(std::popcount(words[w]));
+        if (i % 64 != 0)
+            result += static_cast<std::uint64_t>(std::popcount(words[word] & ((std::uint64_t{ 1 } << (i % 64)) - 1)));
+        return static_cast<std::size_t>(result);
+    }
+
+    // The position of the set bit with rank k (select(0) is the first set bit), or size() if fewer than k + 1 bits are set
+    std::size_t select(std::size_t k) const
+    {
+        if (k >= count())
+            return m_bits->size();
+
+        // the last block with fewer than k + 1 set bits before it holds the bit
+        const auto after{ std::upper_bound(m_before.begin(), m_before.end(), static_cast<std::uint64_t>(k)) };
+        const auto block{ static_cast<std::size_t>(after - m_before.begin()) - 1 };
+        std::uint64_t remaining{ k - m_before[block] };
+
+        const std::uint64_t* words{ m_bits->words().data() };
+        std::size_t word{ block * wordsPerBlock };
+        for (;; ++word)
+        {
+            const auto inWord{ static_cast<std::uint64_t>(std::popcount(words[word])) };
+            if (remaining < inWord)
+                break;
+            remaining -= inWord;
+        }
+        return word * 64 + selectInWord(words[word], static_cast<unsigned int>(remaining));
+    }
+
+private:
+    static constexpr std::size_t wordsPerBlock{ BitVectorSimd::detail::wordsPerLine };
+
+    const BitVector* m_bits{};
+    std::vector<std::uint64_t> m_before{}; // m_before[b] = set bits in blocks [0, b)
+
+    // The position of the set bit with rank k inside word (which has more than k set bits).
+    // Halves the search three times with popcounts, then finishes within one byte.
+    static std::size_t selectInWord(std::uint64_t word, unsigned int k)
+    {
+        std::size_t position{ 0 };
+        for (unsigned int width{ 32 }; width >= 8; width /= 2)
+        {
+            const auto low{ static_cast<unsigned int>(std::popcount(word & ((std::uint64_t{ 1 } << width) - 1))) };
+            if (k >= low)
+            {
+                k -= low;
+                word >>= width;
+                position += width;
+            }
+        }
+
+        for (; k > 0; --k)
+            word &= word - 1; // clear the lowest set bit
+        return position + static_cast<std::size_t>(std::countr_zero(word));
+    }
+};
+
+#endif
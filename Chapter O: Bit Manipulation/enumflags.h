@@ -0,0 +1,130 @@
+#ifndef ENUMFLAGS_H
+#define ENUMFLAGS_H
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+// A set of bit flags named by a scoped enum, instead of loose constexpr int positions into a std::bitset
+// ("bit flags and manipulation.cpp") or hand-written masks ("bit masks.cpp").
+// The enumerators are the bit positions 0, 1, 2, ..., and the last one must be maxFlags (the number of flags):
+//
+//     enum class Mood { hungry, sad, mad, happy, maxFlags };
+//     EnumFlags<Mood> me{ Mood::hungry, Mood::mad };
+//     me.set(Mood::happy);
+//     if (me.test(Mood::sad)) ...
+//     for (Mood mood : me) ...      // visits the set flags, lowest first
+//
+// An EnumFlags is stored in the smallest unsigned integer with enough bits (EnumFlags<Mood> is 1 byte), everything is
+// constexpr, and every operation is the same mask arithmetic you'd write by hand (see benchmarks/enum flags.cpp),
+// but a flag from one enum can't be mixed up with a flag from another, or with a plain integer.
+template <typename E>
+concept FlagEnum = std::is_enum_v<E> && !std::is_convertible_v<E, std::underlying_type_t<E>> // a scoped enum (std::is_scoped_enum in C++23)
+                && requires { E::maxFlags; };
+
+template <FlagEnum E>
+class EnumFlags
+{
+public:
+    static constexpr std::size_t flagCount{ static_cast<std::size_t>(E::maxFlags) };
+    static_assert(flagCount <= 64, "EnumFlags holds at most 64 flags");
+
+    // the smallest unsigned integer type with at least flagCount bits
+    using Bits = std::conditional_t<flagCount <= 8, std::uint8_t,
+                 std::conditional_t<flagCount <= 16, std::uint16_t,
+                 std::conditional_t<flagCount <= 32, std::uint32_t, std::uint64_t>>>;
+
+    static constexpr Bits allBits{ static_cast<Bits>(flagCount == 64 ? ~Bits{ 0 } : (std::uint64_t{ 1 } << flagCount) - 1) };
+
+    constexpr EnumFlags() noexcept = default;
+    constexpr EnumFlags(E flag) noexcept : m_bits{ maskOf(flag) } {}
+    constexpr EnumFlags(std::initializer_list<E> flags) noexcept
+    {
+        for (E flag : flags)
+            m_bits |= maskOf(flag);
+    }
+
+    // For loading flags that were saved as an integer (bits outside the flags are dropped)
+    static constexpr EnumFlags fromBits(Bits bits) noexcept
+    {
+        EnumFlags flags{};
+        flags.m_bits = static_cast<Bits>(bits & allBits);
+        return flags;
+    }
+
+    constexpr Bits bits() const noexcept { return m_bits; }
+
+    constexpr bool test(E flag) const noexcept { return (m_bits & maskOf(flag)) != 0; }
+    constexpr bool any() const noexcept { return m_bits != 0; }
+    constexpr bool all() const noexcept { return m_bits == allBits; }
+    constexpr bool none() const noexcept { return m_bits == 0; }
+    constexpr int count() const noexcept { return std::popcount(m_bits); }
+    static constexpr std::size_t size() noexcept { return flagCount; }
+
+    // true if every flag in flags is set
+    constexpr bool testAll(EnumFlags flags) const noexcept { return (m_bits & flags.m_bits) == flags.m_bits; }
+    // true if any flag in flags is set
+    constexpr bool testAny(EnumFlags flags) const noexcept { return (m_bits & flags.m_bits) != 0; }
+
+    constexpr EnumFlags& set(EnumFlags flags) noexcept { m_bits |= flags.m_bits; return *this; }
+    constexpr EnumFlags& set() noexcept { m_bits = allBits; return *this; }
+    constexpr EnumFlags& reset(EnumFlags flags) noexcept { m_bits &= static_cast<Bits>(~flags.m_bits); return *this; }
+    constexpr EnumFlags& reset() noexcept { m_bits = 0; return *this; }
+    constexpr EnumFlags& flip(EnumFlags flags) noexcept { m_bits ^= flags.m_bits; return *this; }
+    constexpr EnumFlags& flip() noexcept { m_bits ^= allBits; return *this; }
+
+    constexpr EnumFlags& operator|=(EnumFlags other) noexcept { m_bits |= other.m_bits; return *this; }
+    constexpr EnumFlags& operator&=(EnumFlags other) noexcept { m_bits &= other.m_bits; return *this; }
+    constexpr EnumFlags& operator^=(EnumFlags other) noexcept { m_bits ^= other.m_bits; return *this; }
+
+    friend constexpr EnumFlags operator|(EnumFlags a, EnumFlags b) noexcept { return a |= b; }
+    friend constexpr EnumFlags operator&(EnumFlags a, EnumFlags b) noexcept { return a &= b; }
+    friend constexpr EnumFlags operator^(EnumFlags a, EnumFlags b) noexcept { return a ^= b; }
+    friend constexpr EnumFlags operator~(EnumFlags a) noexcept { return a.flip(); }
+    friend constexpr bool operator==(EnumFlags a, EnumFlags b) noexcept = default;
+
+    // Walks the set flags from lowest to highest, clearing the lowest set bit at each step
+    class Iterator
+    {
+    public:
+        using value_type = E;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr Iterator() noexcept = default;
+        constexpr explicit Iterator(Bits remaining) noexcept : m_remaining{ remaining } {}
+
+        constexpr E operator*() const noexcept { return static_cast<E>(std::countr_zero(m_remaining)); }
+        constexpr Iterator& operator++() noexcept { m_remaining &= static_cast<Bits>(m_remaining - 1); return *this; }
+        constexpr Iterator operator++(int) noexcept { Iterator old{ *this }; ++*this; return old; }
+        friend constexpr bool operator==(Iterator a, Iterator b) noexcept = default;
+
+    private:
+        Bits m_remaining{};
+    };
+
+    constexpr Iterator begin() const noexcept { return Iterator{ m_bits }; }
+    constexpr Iterator end() const noexcept { return Iterator{}; }
+
+private:
+    Bits m_bits{ 0 };
+
+    // flag must be a real flag (not maxFlags or a value cast from past it): a larger shift would drop the bit, or be undefined
+    static constexpr Bits maskOf(E flag) noexcept
+    {
+        assert(static_cast<std::size_t>(flag) < flagCount && "EnumFlags: flag out of range");
+        return static_cast<Bits>(Bits{ 1 } << static_cast<unsigned int>(flag));
+    }
+};
+
+// Lets two flags be combined directly: Mood::hungry | Mood::sad
+template <FlagEnum E>
+constexpr EnumFlags<E> operator|(E a, E b) noexcept
+{
+    return EnumFlags<E>{ a, b };
+}
+
+#endif
@@ -0,0 +1,291 @@
+#ifndef PIXELPLANES_H
+#define PIXELPLANES_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "simddispatch.h"
+
+// Converting whole frames of RGBA8888 pixels to planar channels and back.
+// "bit masks.cpp" takes one std::uint32_t pixel apart with redBits/greenBits/blueBits/alphaBits and a shift per channel.
+// A frame is millions of those, and image filters usually want each channel as its own array (planar), so:
+//   Pixels::split(pixels, planes)   pixel i -> planes.red[i], planes.green[i], planes.blue[i], planes.alpha[i]
+//   Pixels::merge(planes, pixels)   and back again
+// A pixel is 0xRRGGBBAA, as in "bit masks.cpp", so in memory (little-endian) its bytes are alpha, blue, green, red.
+//
+// Like bitvector.h, the loops are compiled for AVX2 (32 pixels per step), SSE2 (16 pixels) and one pixel at a time
+// with the masks and shifts, and run at Simd::level() (simddispatch.h), the best level the CPU supports unless Simd::use() forced a lower one.
+namespace Pixels
+{
+    constexpr std::uint32_t redBits{ 0xFF000000 };
+    constexpr std::uint32_t greenBits{ 0x00FF0000 };
+    constexpr std::uint32_t blueBits{ 0x0000FF00 };
+    constexpr std::uint32_t alphaBits{ 0x000000FF };
+
+    // Four channel arrays of the same length (T is std::uint8_t, or const std::uint8_t for reading)
+    template <typename T>
+    struct BasicPlanes
+    {
+        std::span<T> red{};
+        std::span<T> green{};
+        std::span<T> blue{};
+        std::span<T> alpha{};
+
+        std::size_t size() const { return red.size(); }
+
+        // Planes can be passed wherever ConstPlanes are expected
+        operator BasicPlanes<const T>() const
+            requires(!std::is_const_v<T>)
+        {
+            return { red, green, blue, alpha };
+        }
+    };
+
+    using Planes = BasicPlanes<std::uint8_t>;
+    using ConstPlanes = BasicPlanes<const std::uint8_t>;
+
+    namespace detail
+    {
+        // Pixels [from, count) one at a time, exactly as "bit masks.cpp" does it. Also finishes the SIMD loops' leftovers.
+        inline void splitScalar(const std::uint32_t* pixels, const Planes& planes, std::size_t from, std::size_t count)
+        {
+            for (std::size_t i{ from }; i < count; ++i)
+            {
+                const std::uint32_t pixel{ pixels[i] };
+                planes.red[i] = static_cast<std::uint8_t>((pixel & redBits) >> 24);
+                planes.green[i] = static_cast<std::uint8_t>((pixel & greenBits) >> 16);
+                planes.blue[i] = static_cast<std::uint8_t>((pixel & blueBits) >> 8);
+                planes.alpha[i] = static_cast<std::uint8_t>(pixel & alphaBits);
+            }
+        }
+
+        inline void mergeScalar(const ConstPlanes& planes, std::uint32_t* pixels, std::size_t from, std::size_t count)
+        {
+            for (std::size_t i{ from }; i < count; ++i)
+                pixels[i] = static_cast<std::uint32_t>(planes.red[i]) << 24 | static_cast<std::uint32_t>(planes.green[i]) << 16
+                          | static_cast<std::uint32_t>(planes.blue[i]) << 8 | planes.alpha[i];
+        }
+
+#ifdef SIMD_X86
+        // One channel of the 16 pixels in p0-p3: shift it down and mask it off, then narrow to bytes
+        template <int shift>
+        __m128i channelSse2(__m128i p0, __m128i p1, __m128i p2, __m128i p3)
+        {
+            const __m128i low{ _mm_set1_epi32(0xFF) };
+            const auto take = [&low](__m128i p) { return _mm_and_si128(_mm_srli_epi32(p, shift), low); };
+            return _mm_packus_epi16(_mm_packs_epi32(take(p0), take(p1)), _mm_packs_epi32(take(p2), take(p3)));
+        }
+
+        // The same masks and shifts on 4 pixels per register. Each channel of 16 pixels is narrowed from
+        // 32-bit lanes to bytes with two saturating packs (the values are 0-255, so nothing saturates).
+        // Returns how many pixels it did; the rest are left for splitScalar.
+        inline std::size_t splitSse2(const std::uint32_t* pixels, const Planes& planes, std::size_t count)
+        {
+            std::size_t i{ 0 };
+            for (; i + 16 <= count; i += 16)
+            {
+                const auto* in{ reinterpret_cast<const __m128i*>(pixels + i) };
+                const __m128i p0{ _mm_loadu_si128(in) };
+                const __m128i p1{ _mm_loadu_si128(in + 1) };
+                const __m128i p2{ _mm_loadu_si128(in + 2) };
+                const __m128i p3{ _mm_loadu_si128(in + 3) };
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(planes.red.data() + i), channelSse2<24>(p0, p1, p2, p3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(planes.green.data() + i), channelSse2<16>(p0, p1, p2, p3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(planes.blue.data() + i), channelSse2<8>(p0, p1, p2, p3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(planes.alpha.data() + i), channelSse2<0>(p0, p1, p2, p3));
+            }
+            return i;
+        }
+
+        // Interleaves 16 bytes of each channel back into pixels: alpha with blue and green with red into 16-bit pairs,
+        // then the pairs into 32-bit pixels (bytes alpha, blue, green, red)
+        inline std::size_t mergeSse2(const ConstPlanes& planes, std::uint32_t* pixels, std::size_t count, bool stream)
+        {
+            std::size_t i{ 0 };
+            for (; i + 16 <= count; i += 16)
+            {
+                const auto load = [i](std::span<const std::uint8_t> plane) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(plane.data() + i)); };
+                const __m128i red{ load(planes.red) };
+                const __m128i green{ load(planes.green) };
+                const __m128i blue{ load(planes.blue) };
+                const __m128i alpha{ load(planes.alpha) };
+
+                const __m128i alphaBlueLow{ _mm_unpacklo_epi8(alpha, blue) };
+                const __m128i alphaBlueHigh{ _mm_unpackhi_epi8(alpha, blue) };
+                const __m128i greenRedLow{ _mm_unpacklo_epi8(green, red) };
+                const __m128i greenRedHigh{ _mm_unpackhi_epi8(green, red) };
+
+                auto* out{ reinterpret_cast<__m128i*>(pixels + i) };
+                const __m128i v0{ _mm_unpacklo_epi16(alphaBlueLow, greenRedLow) };
+                const __m128i v1{ _mm_unpackhi_epi16(alphaBlueLow, greenRedLow) };
+                const __m128i v2{ _mm_unpacklo_epi16(alphaBlueHigh, greenRedHigh) };
+                const __m128i v3{ _mm_unpackhi_epi16(alphaBlueHigh, greenRedHigh) };
+                if (stream)
+                {
+                    _mm_stream_si128(out, v0);
+                    _mm_stream_si128(out + 1, v1);
+                    _mm_stream_si128(out + 2, v2);
+                    _mm_stream_si128(out + 3, v3);
+                }
+                else
+                {
+                    _mm_storeu_si128(out, v0);
+                    _mm_storeu_si128(out + 1, v1);
+                    _mm_storeu_si128(out + 2, v2);
+                    _mm_storeu_si128(out + 3, v3);
+                }
+            }
+            if (stream)
+                _mm_sfence();
+            return i;
+        }
+
+        // 32 pixels per step, in three shuffles:
+        //   1. vpshufb groups each 128-bit lane's 4 pixels by channel: aaaa bbbb gggg rrrr
+        //   2. vpermd pulls the two lanes' groups together, so each register is 8 alphas, 8 blues, 8 greens, 8 reds
+        //   3. a 4x4 transpose of 64-bit groups across the four registers gives 32 bytes of each channel
+        // The byte shuffle in 1 is its own inverse, so merging runs the same steps backwards with the same table.
+        inline constexpr std::int8_t groupByChannel[16]{ 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15 };
+
+        // Steps 1 and 2 for one register of 8 pixels
+        [[gnu::target("avx2")]] inline __m256i groupAvx2(__m256i pixels, __m256i group, __m256i gather)
+        {
+            return _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(pixels, group), gather);
+        }
+
+        // And back
+        [[gnu::target("avx2")]] inline __m256i ungroupAvx2(__m256i channels, __m256i group, __m256i scatter)
+        {
+            return _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(channels, scatter), group);
+        }
+
+        [[gnu::target("avx2")]] inline std::size_t splitAvx2(const std::uint32_t* pixels, const Planes& planes, std::size_t count)
+        {
+            const __m128i lane{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(groupByChannel)) };
+            const __m256i group{ _mm256_broadcastsi128_si256(lane) };
+            const __m256i gather{ _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7) };
+
+            std::size_t i{ 0 };
+            for (; i + 32 <= count; i += 32)
+            {
+                const auto* in{ reinterpret_cast<const __m256i*>(pixels + i) };
+                const __m256i v0{ groupAvx2(_mm256_loadu_si256(in), group, gather) }; // alpha 0-7, blue 0-7, green 0-7, red 0-7
+                const __m256i v1{ groupAvx2(_mm256_loadu_si256(in + 1), group, gather) }; // the same for pixels 8-15
+                const __m256i v2{ groupAvx2(_mm256_loadu_si256(in + 2), group, gather) };
+                const __m256i v3{ groupAvx2(_mm256_loadu_si256(in + 3), group, gather) };
+
+                const __m256i alphaGreenLow{ _mm256_unpacklo_epi64(v0, v1) };  // alpha 0-15 | green 0-15
+                const __m256i blueRedLow{ _mm256_unpackhi_epi64(v0, v1) };     // blue 0-15  | red 0-15
+                const __m256i alphaGreenHigh{ _mm256_unpacklo_epi64(v2, v3) }; // alpha 16-31 | green 16-31
+                const __m256i blueRedHigh{ _mm256_unpackhi_epi64(v2, v3) };
+
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes.alpha.data() + i), _mm256_permute2x128_si256(alphaGreenLow, alphaGreenHigh, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes.green.data() + i), _mm256_permute2x128_si256(alphaGreenLow, alphaGreenHigh, 0x31));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes.blue.data() + i), _mm256_permute2x128_si256(blueRedLow, blueRedHigh, 0x20));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(planes.red.data() + i), _mm256_permute2x128_si256(blueRedLow, blueRedHigh, 0x31));
+            }
+            return i;
+        }
+
+        [[gnu::target("avx2")]] inline std::size_t mergeAvx2(const ConstPlanes& planes, std::uint32_t* pixels, std::size_t count, bool stream)
+        {
+            const __m128i lane{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(groupByChannel)) };
+            const __m256i group{ _mm256_broadcastsi128_si256(lane) };
+            const __m256i scatter{ _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7) }; // undoes the gather in splitAvx2
+
+            std::size_t i{ 0 };
+            for (; i + 32 <= count; i += 32)
+            {
+                const __m256i red{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes.red.data() + i)) };
+                const __m256i green{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes.green.data() + i)) };
+                const __m256i blue{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes.blue.data() + i)) };
+                const __m256i alpha{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes.alpha.data() + i)) };
+
+                const __m256i alphaGreenLow{ _mm256_permute2x128_si256(alpha, green, 0x20) };
+                const __m256i blueRedLow{ _mm256_permute2x128_si256(blue, red, 0x20) };
+                const __m256i alphaGreenHigh{ _mm256_permute2x128_si256(alpha, green, 0x31) };
+                const __m256i blueRedHigh{ _mm256_permute2x128_si256(blue, red, 0x31) };
+
+                auto* out{ reinterpret_cast<__m256i*>(pixels + i) };
+                const __m256i v0{ ungroupAvx2(_mm256_unpacklo_epi64(alphaGreenLow, blueRedLow), group, scatter) };
+                const __m256i v1{ ungroupAvx2(_mm256_unpackhi_epi64(alphaGreenLow, blueRedLow), group, scatter) };
+                const __m256i v2{ ungroupAvx2(_mm256_unpacklo_epi64(alphaGreenHigh, blueRedHigh), group, scatter) };
+                const __m256i v3{ ungroupAvx2(_mm256_unpackhi_epi64(alphaGreenHigh, blueRedHigh), group, scatter) };
+                if (stream)
+                {
+                    _mm256_stream_si256(out, v0);
+                    _mm256_stream_si256(out + 1, v1);
+                    _mm256_stream_si256(out + 2, v2);
+                    _mm256_stream_si256(out + 3, v3);
+                }
+                else
+                {
+                    _mm256_storeu_si256(out, v0);
+                    _mm256_storeu_si256(out + 1, v1);
+                    _mm256_storeu_si256(out + 2, v2);
+                    _mm256_storeu_si256(out + 3, v3);
+                }
+            }
+            if (stream)
+                _mm_sfence();
+            return i;
+        }
+#endif
+    }
+
+    // Splits pixels into planes, which must each be at least as long as pixels
+    // Sample call: Pixels::split(frame, { red, green, blue, alpha });
+    inline void split(std::span<const std::uint32_t> pixels, const Planes& planes)
+    {
+        assert(planes.red.size() >= pixels.size() && planes.green.size() >= pixels.size()
+               && planes.blue.size() >= pixels.size() && planes.alpha.size() >= pixels.size());
+
+        std::size_t done{ 0 };
+        switch (Simd::level())
+        {
+#ifdef SIMD_X86
+        case Simd::Level::avx2: done = detail::splitAvx2(pixels.data(), planes, pixels.size()); break;
+        case Simd::Level::sse2: done = detail::splitSse2(pixels.data(), planes, pixels.size()); break;
+#endif
+        default: break;
+        }
+        detail::splitScalar(pixels.data(), planes, done, pixels.size());
+    }
+
+    // Frames at least this many pixels (4 MB, more than most L2 caches hold) are merged with streaming stores, which write
+    // the pixels straight to memory instead of first reading every cache line they overwrite into the cache.
+    // That saves a third of the memory traffic of a large merge. (Splitting writes to four places at once, which
+    // the CPU's write-combining buffers handle worse, and streaming didn't pay off there.)
+    constexpr std::size_t streamingPixels{ 1 << 20 };
+
+    // Packs planes back into pixels, which must be at least planes.size() long
+    inline void merge(const ConstPlanes& planes, std::span<std::uint32_t> pixels)
+    {
+        const std::size_t count{ planes.size() };
+        assert(pixels.size() >= count && planes.green.size() >= count && planes.blue.size() >= count && planes.alpha.size() >= count);
+
+        // streaming stores need aligned addresses, so do the pixels before the first 32-byte boundary one at a time
+        const bool stream{ Simd::level() != Simd::Level::scalar && count >= streamingPixels };
+        const std::size_t start{ stream ? (32 - reinterpret_cast<std::uintptr_t>(pixels.data()) % 32) % 32 / sizeof(std::uint32_t) : 0 };
+        detail::mergeScalar(planes, pixels.data(), 0, start);
+
+        [[maybe_unused]] const ConstPlanes rest{ planes.red.subspan(start), planes.green.subspan(start), planes.blue.subspan(start),
+                                                 planes.alpha.subspan(start) };
+        std::size_t done{ start };
+        switch (Simd::level())
+        {
+#ifdef SIMD_X86
+        case Simd::Level::avx2: done += detail::mergeAvx2(rest, pixels.data() + start, count - start, stream); break;
+        case Simd::Level::sse2: done += detail::mergeSse2(rest, pixels.data() + start, count - start, stream); break;
+#endif
+        default: break;
+        }
+        detail::mergeScalar(planes, pixels.data(), done, count);
+    }
+}
+
+#endif
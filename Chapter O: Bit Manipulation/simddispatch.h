@@ -0,0 +1,68 @@
+#ifndef SIMDDISPATCH_H
+#define SIMDDISPATCH_H
+
+#include <algorithm>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Picking a SIMD level at runtime, shared by bitvector.h and pixelplanes.h.
+// Their loops are compiled three times, for AVX2, SSE2 and plain integers, and switch on Simd::level() to run the best
+// one the CPU running the program supports (__builtin_cpu_supports), so one binary runs everywhere.
+// Simd::use() can force a slower level, e.g. to benchmark them against each other. There is one level for the whole
+// program, so it applies to BitVector and Pixels alike.
+namespace Simd
+{
+    enum class Level
+    {
+        scalar,
+        sse2,
+        avx2,
+    };
+
+    // The best level this CPU supports
+    inline Level detected()
+    {
+#ifdef SIMD_X86
+        static const Level level{ [] {
+            __builtin_cpu_init(); // in case this runs before the runtime has set up the CPU info (during static initialization)
+            return __builtin_cpu_supports("avx2") ? Level::avx2 : Level::sse2; // SSE2 is part of x86-64
+        }() };
+        return level;
+#else
+        return Level::scalar;
+#endif
+    }
+
+    // Whether the CPU has the popcnt instruction (all AVX2 CPUs do, but not every x86-64 CPU)
+    inline bool hasPopcnt()
+    {
+#ifdef SIMD_X86
+        static const bool popcnt{ [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("popcnt") != 0;
+        }() };
+        return popcnt;
+#else
+        return false;
+#endif
+    }
+
+    namespace detail
+    {
+        inline Level& current()
+        {
+            static Level level{ detected() };
+            return level;
+        }
+    }
+
+    inline Level level() { return detail::current(); }
+
+    // Uses level from now on, or the best supported level if the CPU doesn't have it
+    inline void use(Level level) { detail::current() = std::min(level, detected()); }
+}
+
+#endif